@@ -0,0 +1,232 @@
+#include "persistent_region.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define PREGION_HEADER_SIZE 64          // Header rounded up to a cache line
+
+_Static_assert(sizeof(pregion_header_t) <= PREGION_HEADER_SIZE, "header outgrew its slot");
+
+static pregion_header_t *header(const pregion_t *r) {
+    return (pregion_header_t *)r->base;
+}
+
+/* =============================================================================
+ * SECTION 1: Checksum
+ * =============================================================================
+ * Four independent multiply-rotate lanes over 32-byte blocks, so validating
+ * a warm region runs at memory speed rather than one byte per step.
+ */
+
+#define P1 0x9E3779B185EBCA87ull
+#define P2 0xC2B2AE3D27D4EB4Full
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t lane_round(uint64_t h, uint64_t w) {
+    return rotl64(h + w * P2, 31) * P1;
+}
+
+uint64_t pregion_hash(const void *data, size_t len, uint64_t seed) {
+    const uint8_t *p = data;
+    uint64_t h = seed ^ (len * P1);
+
+    if (len >= 32) {
+        uint64_t v[4] = { seed + P1 + P2, seed + P2, seed, seed - P1 };
+        while (len >= 32) {
+            for (int i = 0; i < 4; i++) {
+                uint64_t w;
+                memcpy(&w, p + 8 * i, 8);
+                v[i] = lane_round(v[i], w);
+            }
+            p += 32;
+            len -= 32;
+        }
+        h ^= rotl64(v[0], 1) + rotl64(v[1], 7) + rotl64(v[2], 12) + rotl64(v[3], 18);
+        for (int i = 0; i < 4; i++) {
+            h = (h ^ lane_round(0, v[i])) * P1;
+        }
+    }
+    while (len >= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = rotl64(h ^ lane_round(0, w), 27) * P1;
+        p += 8;
+        len -= 8;
+    }
+    while (len > 0) {
+        h = rotl64(h ^ (*p++ * P2), 11) * P1;
+        len--;
+    }
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    return h;
+}
+
+static uint64_t region_checksum(const pregion_t *r) {
+    const pregion_header_t *hdr = header(r);
+    uint64_t seed = hdr->used * P1 ^ hdr->root;
+    return pregion_hash(r->base + PREGION_HEADER_SIZE, hdr->used - PREGION_HEADER_SIZE, seed);
+}
+
+/* =============================================================================
+ * SECTION 2: Attach, validate, fall back
+ * ============================================================================= */
+
+static const char *validate(const pregion_t *r, size_t file_size, uint64_t layout_hash) {
+    const pregion_header_t *hdr = header(r);
+    if (file_size == 0) {
+        return "new file";
+    }
+    if (file_size != r->size || hdr->size != r->size) {
+        return "size changed";
+    }
+    if (hdr->magic != PREGION_MAGIC) {
+        return "bad magic";
+    }
+    if (hdr->version != PREGION_VERSION || hdr->header_size != PREGION_HEADER_SIZE) {
+        return "format version changed";
+    }
+    if (hdr->layout_hash != layout_hash) {
+        return "layout hash changed";
+    }
+    if (!hdr->clean) {
+        return "not closed cleanly";
+    }
+    if (hdr->used < PREGION_HEADER_SIZE || hdr->used > r->size ||
+        (hdr->root != 0 && (hdr->root < PREGION_HEADER_SIZE || hdr->root >= hdr->used))) {
+        return "header out of range";
+    }
+    if (hdr->checksum != region_checksum(r)) {
+        return "checksum mismatch";
+    }
+    return NULL;
+}
+
+static void format(pregion_t *r, uint64_t layout_hash) {
+    pregion_header_t *hdr = header(r);
+    memset(hdr, 0, PREGION_HEADER_SIZE);
+    hdr->magic = PREGION_MAGIC;
+    hdr->version = PREGION_VERSION;
+    hdr->header_size = PREGION_HEADER_SIZE;
+    hdr->layout_hash = layout_hash;
+    hdr->size = r->size;
+    hdr->used = PREGION_HEADER_SIZE;
+}
+
+int pregion_open(pregion_t *r, const char *path, size_t size, uint64_t layout_hash) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size = (size + page - 1) & ~(page - 1);
+
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return -1;
+    }
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        goto fail;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        goto fail;
+    }
+    if ((size_t)st.st_size != size && ftruncate(fd, (off_t)size) != 0) {
+        goto fail;
+    }
+
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        goto fail;
+    }
+    r->base = base;
+    r->size = size;
+    r->fd = fd;
+
+    r->cold_reason = validate(r, (size_t)st.st_size, layout_hash);
+    if (r->cold_reason == NULL) {
+        r->start = PREGION_WARM;
+    } else {
+        // Cold: drop the old contents, so the pages read back as zeros
+        // without being touched, then start from an empty arena
+        if (st.st_size != 0 && (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t)size) != 0)) {
+            munmap(base, size);
+            goto fail;
+        }
+        format(r, layout_hash);
+        r->start = PREGION_COLD;
+    }
+    // Until the next commit a crash leaves the region marked unclean
+    header(r)->clean = 0;
+    return r->start;
+
+fail:;
+    int err = errno;
+    close(fd);
+    errno = err;
+    return -1;
+}
+
+int pregion_commit(pregion_t *r) {
+    pregion_header_t *hdr = header(r);
+    hdr->checksum = region_checksum(r);
+    hdr->clean = 1;
+    return msync(r->base, hdr->used, MS_SYNC);
+}
+
+int pregion_close(pregion_t *r) {
+    int rc = pregion_commit(r);
+    int err = errno;
+    munmap(r->base, r->size);
+    close(r->fd);       // Releases the flock
+    r->base = NULL;
+    errno = err;
+    return rc;
+}
+
+/* =============================================================================
+ * SECTION 3: Allocation and the root object
+ * ============================================================================= */
+
+void *pregion_alloc(pregion_t *r, size_t size, size_t align) {
+    pregion_header_t *hdr = header(r);
+    if (align == 0 || (align & (align - 1)) != 0) {
+        return NULL;
+    }
+    // used <= r->size, so neither the padding nor the size can wrap off
+    uint64_t off = hdr->used;
+    uint64_t pad = (align - (off & (align - 1))) & (align - 1);
+    if (pad > r->size - off) {
+        return NULL;
+    }
+    off += pad;
+    if (size > r->size - off) {
+        return NULL;
+    }
+    hdr->used = off + size;
+    hdr->clean = 0;
+    return r->base + off;       // Fresh file pages are already zero
+}
+
+void pregion_set_root(pregion_t *r, void *root) {
+    header(r)->root = pregion_off(r, root);
+    header(r)->clean = 0;
+}
+
+void *pregion_root(const pregion_t *r) {
+    return pregion_ptr(r, header(r)->root);
+}
+
+size_t pregion_used(const pregion_t *r) {
+    return header(r)->used;
+}
+
+const char *pregion_cold_reason(const pregion_t *r) {
+    return r->cold_reason;
+}
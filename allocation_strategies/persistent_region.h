@@ -0,0 +1,118 @@
+#ifndef PERSISTENT_REGION_H
+#define PERSISTENT_REGION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * File-Backed Persistent Region for Warm Restarts
+ * =============================================================================
+ * A `static char buffer[100]` outlives every call but not the process. A
+ * pregion_t is the next step: an arena in a MAP_SHARED file mapping, so
+ * tables built by one run can be attached by the next instead of rebuilt.
+ *
+ *     pregion_t r;
+ *     if (pregion_open(&r, "/var/lib/app/tables.bin", 64 << 20, LAYOUT) == PREGION_COLD) {
+ *         tables_t *t = pregion_alloc(&r, sizeof(*t), 8);
+ *         build_tables(&r, t);                // Expensive, once
+ *         pregion_set_root(&r, t);
+ *     }
+ *     tables_t *t = pregion_root(&r);
+ *     ...
+ *     pregion_close(&r);                      // Checksums and syncs
+ *
+ * The file may be mapped at a different address on every run, so objects
+ * inside it link to each other with pregion_off_t offsets from the region
+ * base, never with pointers.
+ *
+ * An attach is warm only if the header's magic, format version, size and
+ * the caller's layout hash all match, the last run closed the region
+ * cleanly, and the checksum over the used bytes agrees. Anything else - a
+ * missing file, a changed struct, a crash mid-update, a flipped bit - falls
+ * back to a cold start with an empty region, and pregion_cold_reason() says
+ * why.
+ */
+
+#define PREGION_MAGIC       0x4E4F494745524750ull      // "PREGION\0" in little-endian
+#define PREGION_VERSION     1
+
+typedef uint64_t pregion_off_t;         // 0 is the null offset (it is the header)
+
+typedef enum {
+    PREGION_COLD = 0,                   // Region is empty and must be rebuilt
+    PREGION_WARM = 1                    // Previous contents re-attached
+} pregion_start_t;
+
+typedef struct {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t layout_hash;               // Caller's description of its structs
+    uint64_t size;                      // Mapping size the region was created with
+    uint64_t used;                      // Bump pointer, as an offset
+    uint64_t root;                      // Offset of the application's root object
+    uint64_t checksum;                  // Over used, root and [header_size, used)
+    uint32_t clean;                     // Set by pregion_commit(), cleared while attached
+    uint32_t reserved;
+} pregion_header_t;
+
+typedef struct {
+    uint8_t *base;
+    size_t size;
+    int fd;
+    pregion_start_t start;
+    const char *cold_reason;            // NULL after a warm start
+} pregion_t;
+
+/**
+ * @brief Map (creating if needed) a size-byte region backed by path
+ * The file is locked for exclusive use until pregion_close().
+ * @return PREGION_WARM or PREGION_COLD, or -1 with errno set
+ */
+int pregion_open(pregion_t *r, const char *path, size_t size, uint64_t layout_hash);
+
+/**
+ * @brief Checksum the used bytes, mark the region clean and msync() it
+ * The region stays attached and is marked dirty again on the next allocation
+ * or pregion_set_root(); writes through plain pointers must be followed by
+ * another commit to count.
+ * @return 0 on success, -1 with errno set
+ */
+int pregion_commit(pregion_t *r);
+
+/**
+ * @brief pregion_commit(), then unmap and unlock
+ */
+int pregion_close(pregion_t *r);
+
+/**
+ * @brief Bump-allocate zeroed bytes inside the region
+ * @param align Nonzero power of two
+ * @return NULL when the region is full or align is invalid
+ */
+void *pregion_alloc(pregion_t *r, size_t size, size_t align);
+
+void pregion_set_root(pregion_t *r, void *root);
+void *pregion_root(const pregion_t *r);
+
+/**
+ * @brief Bytes allocated so far, including the header
+ */
+size_t pregion_used(const pregion_t *r);
+
+const char *pregion_cold_reason(const pregion_t *r);
+
+/**
+ * @brief 64-bit hash used for the checksum, exported for layout hashes
+ */
+uint64_t pregion_hash(const void *data, size_t len, uint64_t seed);
+
+static inline void *pregion_ptr(const pregion_t *r, pregion_off_t off) {
+    return off != 0 ? r->base + off : NULL;
+}
+
+static inline pregion_off_t pregion_off(const pregion_t *r, const void *p) {
+    return p != NULL ? (pregion_off_t)((const uint8_t *)p - r->base) : 0;
+}
+
+#endif /* PERSISTENT_REGION_H */
@@ -0,0 +1,252 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "persistent_region.h"
+
+/* =============================================================================
+ * SECTION 1: The tables a service rebuilds at every startup
+ * =============================================================================
+ * A 2M-entry linearisation table (each entry inverts a sensor polynomial
+ * with Newton's method) and a name -> device index. Everything links by
+ * offset, so the region can land at any address.
+ */
+
+#define LUT_SIZE        (1u << 21)
+#define DEVICE_COUNT    100000u
+#define SLOT_COUNT      (1u << 18)     // Load factor under 0.4
+#define REGION_SIZE     (64u << 20)
+
+typedef struct {
+    pregion_off_t name;         // NUL-terminated, inside the region
+    uint32_t id;
+    uint32_t route;
+    float gain;
+    float offset;
+} device_t;
+
+typedef struct {
+    uint32_t lut_size;
+    uint32_t device_count;
+    uint32_t slot_mask;
+    uint32_t reserved;
+    pregion_off_t lut;          // float[lut_size]
+    pregion_off_t slots;        // pregion_off_t[slot_mask + 1], each to a device_t
+} tables_t;
+
+static uint64_t layout_hash(int variant) {
+    // Anything that changes the meaning of the bytes belongs in here
+    const uint64_t layout[] = {
+        sizeof(tables_t), sizeof(device_t), LUT_SIZE, DEVICE_COUNT, SLOT_COUNT, (uint64_t)variant,
+    };
+    return pregion_hash(layout, sizeof(layout), 0);
+}
+
+// Temperature for a normalised ADC reading: solve p(t) = x by Newton's method
+static float linearise(uint32_t i) {
+    double x = (double)i / LUT_SIZE;
+    double t = x;
+    for (int k = 0; k < 40; k++) {
+        double p = 0.02 + t * (0.9 + t * (0.15 - t * 0.07));
+        double dp = 0.9 + t * (0.3 - t * 0.21);
+        t -= (p - x) / dp;
+    }
+    return (float)(t * 150.0 - 40.0);
+}
+
+static void device_name(char *buf, size_t size, uint32_t id) {
+    snprintf(buf, size, "sensor-%06u.line%u", id, id % 7);
+}
+
+static uint64_t name_hash(const char *name) {
+    return pregion_hash(name, strlen(name), 0x5EED);
+}
+
+static tables_t *build_tables(pregion_t *r) {
+    tables_t *t = pregion_alloc(r, sizeof(*t), 8);
+    float *lut = pregion_alloc(r, LUT_SIZE * sizeof(float), 64);
+    pregion_off_t *slots = pregion_alloc(r, SLOT_COUNT * sizeof(pregion_off_t), 64);
+    if (t == NULL || lut == NULL || slots == NULL) {
+        return NULL;
+    }
+    t->lut_size = LUT_SIZE;
+    t->device_count = DEVICE_COUNT;
+    t->slot_mask = SLOT_COUNT - 1;
+    t->lut = pregion_off(r, lut);
+    t->slots = pregion_off(r, slots);
+
+    for (uint32_t i = 0; i < LUT_SIZE; i++) {
+        lut[i] = linearise(i);
+    }
+    for (uint32_t id = 0; id < DEVICE_COUNT; id++) {
+        char name[32];
+        device_name(name, sizeof(name), id);
+        size_t len = strlen(name) + 1;
+        device_t *d = pregion_alloc(r, sizeof(*d), 8);
+        char *copy = pregion_alloc(r, len, 1);
+        if (d == NULL || copy == NULL) {
+            return NULL;
+        }
+        memcpy(copy, name, len);
+        d->name = pregion_off(r, copy);
+        d->id = id;
+        d->route = (id * 2654435761u) >> 20;
+        d->gain = 1.0f + (float)(id % 100) * 1e-3f;
+        d->offset = lut[id % LUT_SIZE];
+
+        uint64_t s = name_hash(name) & t->slot_mask;
+        while (slots[s] != 0) {
+            s = (s + 1) & t->slot_mask;
+        }
+        slots[s] = pregion_off(r, d);
+    }
+    pregion_set_root(r, t);
+    return t;
+}
+
+static const device_t *find_device(const pregion_t *r, const tables_t *t, const char *name) {
+    const pregion_off_t *slots = pregion_ptr(r, t->slots);
+    for (uint64_t s = name_hash(name) & t->slot_mask; slots[s] != 0; s = (s + 1) & t->slot_mask) {
+        const device_t *d = pregion_ptr(r, slots[s]);
+        if (strcmp(pregion_ptr(r, d->name), name) == 0) {
+            return d;
+        }
+    }
+    return NULL;
+}
+
+// What the service does once it is up: spot-check both tables
+static int check_tables(const pregion_t *r, const tables_t *t) {
+    const float *lut = pregion_ptr(r, t->lut);
+    uint32_t x = 12345;
+    for (int i = 0; i < 2000; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        uint32_t id = x % DEVICE_COUNT;
+        char name[32];
+        device_name(name, sizeof(name), id);
+        const device_t *d = find_device(r, t, name);
+        if (d == NULL || d->id != id || d->offset != lut[id] || lut[x % LUT_SIZE] != linearise(x % LUT_SIZE)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* =============================================================================
+ * SECTION 2: One service start, run in its own process
+ * ============================================================================= */
+
+static double ms_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec * 1e-6;
+}
+
+// mode: "normal", "crash" (exit without closing) or "layout2" (changed structs)
+static int service_start(const char *path, const char *mode, const char *expect) {
+    double t0 = ms_now();
+    pregion_t r;
+    int start = pregion_open(&r, path, REGION_SIZE, layout_hash(strcmp(mode, "layout2") == 0));
+    if (start < 0) {
+        perror("pregion_open");
+        return 1;
+    }
+    tables_t *t = start == PREGION_WARM ? pregion_root(&r) : build_tables(&r);
+    int ok = t != NULL && check_tables(&r, t) == 0;
+    double t1 = ms_now();
+
+    const char *got = start == PREGION_WARM ? "warm" : "cold";
+    printf("  %s  %-22s %5.1f MiB at %p  startup %8.2f ms", got,
+           start == PREGION_WARM ? "" : pregion_cold_reason(&r),
+           (double)pregion_used(&r) / (1 << 20), (void *)r.base, t1 - t0);
+    if (strcmp(mode, "crash") == 0) {
+        printf("  (killed before close)\n");
+        fflush(stdout);
+        _exit(strcmp(got, expect) != 0 || !ok);
+    }
+    if (pregion_close(&r) != 0) {
+        perror("pregion_close");
+        return 1;
+    }
+    printf("  close %6.2f ms%s\n", ms_now() - t1, ok ? "" : "  TABLES WRONG");
+    return strcmp(got, expect) != 0 || !ok;
+}
+
+/* =============================================================================
+ * SECTION 3: Driver - restart the service under different conditions
+ * ============================================================================= */
+
+static int failures;
+
+static void restart(const char *path, const char *mode, const char *expect) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        // exec rather than just fork, so every start gets a fresh address space
+        execl("/proc/self/exe", "persistent_region_demo", "--start", path, mode, expect, (char *)NULL);
+        _exit(127);
+    }
+    int status;
+    if (pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        printf("  ^ FAILED (expected %s)\n", expect);
+        failures++;
+    }
+}
+
+static void flip_byte(const char *path, off_t where) {
+    int fd = open(path, O_RDWR);
+    uint8_t b;
+    if (fd < 0 || pread(fd, &b, 1, where) != 1) {
+        failures++;
+    } else {
+        b ^= 0x10;
+        if (pwrite(fd, &b, 1, where) != 1) {
+            failures++;
+        }
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc == 5 && strcmp(argv[1], "--start") == 0) {
+        return service_start(argv[2], argv[3], argv[4]);
+    }
+    const char *path = argc > 1 ? argv[1] : "/tmp/persistent_region_demo.bin";
+    if (unlink(path) != 0 && errno != ENOENT) {
+        perror(path);
+        return 1;
+    }
+
+    printf("First start, no file yet:\n");
+    restart(path, "normal", "cold");
+    printf("Restarts:\n");
+    for (int i = 0; i < 4; i++) {
+        restart(path, "normal", "warm");
+    }
+
+    printf("One bit flipped inside the lookup table:\n");
+    flip_byte(path, 4 << 20);
+    restart(path, "normal", "cold");
+
+    printf("Crash while attached, then restart:\n");
+    restart(path, "crash", "warm");
+    restart(path, "normal", "cold");
+
+    printf("New build with a changed layout, then the old one again:\n");
+    restart(path, "layout2", "cold");
+    restart(path, "normal", "cold");
+    restart(path, "normal", "warm");
+
+    unlink(path);
+    printf("\n%s\n", failures == 0 ? "All starts behaved as expected" : "FAILURES");
+    return failures != 0;
+}
@@ -0,0 +1,174 @@
+#include "stack_usage.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* =============================================================================
+ * SECTION 1: Painting and scanning
+ * ============================================================================= */
+
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static stack_task_t *registry;
+
+// Both helpers are forced inline: stack_measure() runs them below its own
+// stack pointer, where a call frame would land in the painted region
+static inline __attribute__((always_inline)) void paint(uint64_t *low, uint64_t *high) {
+    // volatile so the compiler cannot turn this into a memset() call
+    for (volatile uint64_t *p = low; p < high; p++) {
+        *p = STACK_PAINT_WORD;
+    }
+}
+
+/**
+ * @brief Number of untouched bytes, counting up from the deep end
+ */
+static inline __attribute__((always_inline)) size_t untouched(const uint64_t *low, const uint64_t *high) {
+    const volatile uint64_t *p = low;
+    while (p < high && *p == STACK_PAINT_WORD) {
+        p++;
+    }
+    return (size_t)((const uint8_t *)p - (const uint8_t *)low);
+}
+
+/* =============================================================================
+ * SECTION 2: Tasks on painted stacks
+ * ============================================================================= */
+
+int stack_task_create(stack_task_t *task, const char *name, size_t stack_size,
+                      void *(*entry)(void *), void *arg) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    if (stack_size < PTHREAD_STACK_MIN) {
+        stack_size = PTHREAD_STACK_MIN;
+    }
+    stack_size = (stack_size + page - 1) & ~(page - 1);
+
+    uint8_t *map = mmap(NULL, stack_size + page, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (map == MAP_FAILED) {
+        return errno;
+    }
+    if (mprotect(map, page, PROT_NONE) != 0) {
+        int err = errno;
+        munmap(map, stack_size + page);
+        return err;
+    }
+
+    task->name = name;
+    task->base = map + page;
+    task->size = stack_size;
+    task->mapping_size = stack_size + page;
+    task->entry = entry;
+    task->arg = arg;
+
+    // Painting commits every page up front, as a static RTOS stack would be
+    paint((uint64_t *)task->base, (uint64_t *)(task->base + stack_size));
+
+    pthread_attr_t attr;
+    int err = pthread_attr_init(&attr);
+    if (err == 0) {
+        err = pthread_attr_setstack(&attr, task->base, stack_size);
+        if (err == 0) {
+            err = pthread_create(&task->thread, &attr, entry, arg);
+        }
+        pthread_attr_destroy(&attr);
+    }
+    if (err != 0) {
+        munmap(map, task->mapping_size);
+        return err;
+    }
+
+    pthread_mutex_lock(&registry_lock);
+    task->next = registry;
+    registry = task;
+    pthread_mutex_unlock(&registry_lock);
+    return 0;
+}
+
+int stack_task_join(stack_task_t *task, void **result) {
+    return pthread_join(task->thread, result);
+}
+
+void stack_task_destroy(stack_task_t *task) {
+    pthread_mutex_lock(&registry_lock);
+    for (stack_task_t **link = &registry; *link != NULL; link = &(*link)->next) {
+        if (*link == task) {
+            *link = task->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&registry_lock);
+
+    munmap(task->base - (task->mapping_size - task->size), task->mapping_size);
+    task->base = NULL;
+}
+
+size_t stack_high_water(const stack_task_t *task) {
+    const uint64_t *low = (const uint64_t *)task->base;
+    const uint64_t *high = (const uint64_t *)(task->base + task->size);
+    return task->size - untouched(low, high);
+}
+
+/* =============================================================================
+ * SECTION 3: Reporting
+ * =============================================================================
+ * glibc places the thread descriptor and static TLS at the top of a
+ * user-supplied stack, so even an idle thread shows a few KiB used. The
+ * suggested size adds 25% headroom and rounds up to 1 KiB.
+ */
+
+void stack_report(FILE *out) {
+    fprintf(out, "%-12s %10s %10s %6s %10s %10s\n",
+            "task", "size", "high-water", "used", "headroom", "suggested");
+
+    pthread_mutex_lock(&registry_lock);
+    for (const stack_task_t *t = registry; t != NULL; t = t->next) {
+        size_t used = stack_high_water(t);
+        size_t suggested = (used + used / 4 + 1023) & ~(size_t)1023;
+        fprintf(out, "%-12s %10zu %10zu %5.1f%% %10zu %10zu%s\n",
+                t->name, t->size, used, 100.0 * (double)used / (double)t->size,
+                t->size - used, suggested, used + 64 >= t->size ? "  OVERFLOW?" : "");
+    }
+    pthread_mutex_unlock(&registry_lock);
+}
+
+/* =============================================================================
+ * SECTION 4: Measuring one call on the current stack
+ * =============================================================================
+ * Everything below this frame's stack pointer is free, except the red zone
+ * that leaf code may use without moving the pointer. Paint below that, call
+ * fn, and measure from where the call started.
+ */
+
+static inline __attribute__((always_inline)) uint8_t *stack_pointer(void) {
+    uint8_t *sp;
+#if defined(__x86_64__)
+    __asm__ volatile("mov %%rsp, %0" : "=r"(sp));
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ volatile("mov %0, sp" : "=r"(sp));
+#elif defined(__riscv)
+    __asm__ volatile("mv %0, sp" : "=r"(sp));
+#else
+#error "stack_pointer() needs porting to this architecture"
+#endif
+    return sp;
+}
+
+__attribute__((noinline))
+size_t stack_measure(void (*fn)(void *), void *arg, size_t depth) {
+    uint8_t *sp = stack_pointer();
+    uint64_t *high = (uint64_t *)((uintptr_t)(sp - STACK_MEASURE_RESOLUTION) & ~(uintptr_t)7);
+    uint64_t *low = high - depth / sizeof(uint64_t);
+
+    paint(low, high);
+    fn(arg);
+    __asm__ volatile("" : : : "memory");
+
+    size_t free_bytes = untouched(low, high);
+    size_t painted = (size_t)((uint8_t *)high - (uint8_t *)low);
+    if (free_bytes == painted) {
+        return STACK_MEASURE_RESOLUTION;
+    }
+    return (size_t)(sp - (uint8_t *)low) - free_bytes;
+}
@@ -0,0 +1,84 @@
+#ifndef STACK_USAGE_H
+#define STACK_USAGE_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* =============================================================================
+ * Stack High-Water Marks by Stack Painting
+ * =============================================================================
+ * Stack allocation is "limited size but fast" - but how limited does it need
+ * to be? Painting answers that the way RTOS kernels do: fill the stack with
+ * a known pattern before the task runs, and later count how many words at
+ * the far end were never overwritten.
+ *
+ *     stack_task_t uart;
+ *     stack_task_create(&uart, "uart", 64 * 1024, uart_task, NULL);
+ *     ...
+ *     stack_task_join(&uart, NULL);
+ *     stack_report(stdout);          // name, size, high-water mark, headroom
+ *
+ * A single function can be measured on the current stack: stack_measure()
+ * paints the region below its own stack pointer, then calls the function:
+ *
+ *     size_t used = stack_measure(run_example, NULL, 16 * 1024);
+ *
+ * The high-water mark is a lower bound: it only covers the paths that ran.
+ * Pair it with the static -fstack-usage table (stack_usage_report.sh).
+ * Stacks are assumed to grow downwards, as on x86, ARM and RISC-V.
+ */
+
+#define STACK_PAINT_WORD            0xA5A5A5A5A5A5A5A5ull
+#define STACK_MEASURE_RESOLUTION    128     // x86-64 red zone, never painted
+
+typedef struct stack_task {
+    const char *name;
+    uint8_t *base;              // Lowest usable address (just above the guard page)
+    size_t size;
+    size_t mapping_size;        // Including the guard page
+    pthread_t thread;
+    void *(*entry)(void *);
+    void *arg;
+    struct stack_task *next;    // Registry of all tasks, for stack_report()
+} stack_task_t;
+
+/**
+ * @brief Start a thread on a freshly painted stack of stack_size bytes
+ * The stack is mmap()ed with a PROT_NONE guard page below it, so an
+ * overflow faults instead of silently corrupting memory.
+ * @return 0 on success, otherwise an errno value
+ */
+int stack_task_create(stack_task_t *task, const char *name, size_t stack_size,
+                      void *(*entry)(void *), void *arg);
+
+/**
+ * @brief Wait for the thread; its stack stays mapped so it can still be measured
+ */
+int stack_task_join(stack_task_t *task, void **result);
+
+/**
+ * @brief Unregister the task and unmap its stack (after join)
+ */
+void stack_task_destroy(stack_task_t *task);
+
+/**
+ * @brief Deepest stack use so far, in bytes (can be called while it runs)
+ */
+size_t stack_high_water(const stack_task_t *task);
+
+/**
+ * @brief Per-task table: size, high-water mark, headroom and a suggested size
+ */
+void stack_report(FILE *out);
+
+/**
+ * @brief Run fn(arg) and return the deepest stack it used, in bytes
+ * Paints `depth` bytes below the current stack pointer first, so depth must
+ * fit in the remaining stack. Uses below STACK_MEASURE_RESOLUTION bytes are
+ * reported as STACK_MEASURE_RESOLUTION.
+ */
+size_t stack_measure(void (*fn)(void *), void *arg, size_t depth);
+
+#endif /* STACK_USAGE_H */
@@ -0,0 +1,154 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "stack_usage.h"
+
+/* =============================================================================
+ * SECTION 1: Measuring single functions
+ * =============================================================================
+ * The same shapes as allocation.c: a 100-byte buffer, and the 1 KiB-per-call
+ * recursion from the README's "Stack Overflow" example.
+ */
+
+static volatile char sink;
+
+__attribute__((noinline))
+static void stack_buffer_example(void *arg) {
+    (void)arg;
+    char buffer[100];
+    strncpy(buffer, "This is stored on the stack", sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+    sink = buffer[strlen(buffer) - 1];
+}
+
+__attribute__((noinline))
+static void recursive_function(int depth) {
+    volatile char large_buffer[1000];
+    large_buffer[0] = (char)depth;
+    if (depth > 0) {
+        recursive_function(depth - 1);
+    }
+    sink = large_buffer[0];
+}
+
+static void recurse_8(void *arg) {
+    (void)arg;
+    recursive_function(8);
+}
+
+static void printf_call(void *arg) {
+    (void)arg;
+    char line[32];
+    snprintf(line, sizeof(line), "%d %.3f", 42, 3.14159);
+    sink = line[0];
+}
+
+static void measure_functions(void) {
+    // First calls into libc go through the lazy PLT resolver, which saves the
+    // whole vector register file on the stack; measure the steady state
+    stack_buffer_example(NULL);
+    printf_call(NULL);
+
+    printf("Single calls, measured on the main stack:\n");
+    printf("  %-28s %8zu bytes\n", "100-byte buffer", stack_measure(stack_buffer_example, NULL, 64 * 1024));
+    printf("  %-28s %8zu bytes\n", "recursive_function(8)", stack_measure(recurse_8, NULL, 64 * 1024));
+    printf("  %-28s %8zu bytes\n", "snprintf(\"%d %.3f\")", stack_measure(printf_call, NULL, 64 * 1024));
+}
+
+/* =============================================================================
+ * SECTION 2: Tasks on 64 KiB stacks
+ * =============================================================================
+ * Every task gets the same "safe" 64 KiB; the report shows what each needs.
+ */
+
+static void *idle_task(void *arg) {
+    return arg;
+}
+
+// UART receive: a small ring buffer and a byte-at-a-time loop
+static void *uart_task(void *arg) {
+    uint8_t ring[256];
+    unsigned head = 0;
+    for (int i = 0; i < 10000; i++) {
+        ring[head++ & 255] = (uint8_t)i;
+    }
+    sink = (char)ring[(head - 1) & 255];
+    return arg;
+}
+
+// Frame parser: a 4 KiB scratch frame plus a short recursive descent
+static int parse_nested(const char *p, int depth) {
+    char field[512];
+    size_t n = strcspn(p, ";");
+    memcpy(field, p, n < sizeof(field) ? n : sizeof(field) - 1);
+    field[n < sizeof(field) ? n : sizeof(field) - 1] = '\0';
+    if (depth == 0 || p[n] == '\0') {
+        return (int)strlen(field);
+    }
+    return (int)strlen(field) + parse_nested(p + n + 1, depth - 1);
+}
+
+static void *parser_task(void *arg) {
+    char frame[4096];
+    snprintf(frame, sizeof(frame), "TEMP=23.5;HUM=41;V=3.29;P=1013;LUX=220;CO2=415");
+    sink = (char)parse_nested(frame, 6);
+    return arg;
+}
+
+// Logging: formats with snprintf, which is usually the deepest thing around
+static void *logger_task(void *arg) {
+    char line[128];
+    for (int i = 0; i < 100; i++) {
+        snprintf(line, sizeof(line), "[%06d] temp=%.2f state=%s", i, 20.0 + i * 0.01, "ok");
+    }
+    sink = line[0];
+    return arg;
+}
+
+static int run_tasks(void) {
+    static const struct {
+        const char *name;
+        void *(*entry)(void *);
+    } specs[] = {
+        { "idle", idle_task },
+        { "uart_rx", uart_task },
+        { "parser", parser_task },
+        { "logger", logger_task },
+    };
+    enum { NTASKS = sizeof(specs) / sizeof(specs[0]) };
+    stack_task_t tasks[NTASKS];
+
+    for (int i = 0; i < NTASKS; i++) {
+        int err = stack_task_create(&tasks[i], specs[i].name, 64 * 1024, specs[i].entry, NULL);
+        if (err != 0) {
+            fprintf(stderr, "stack_task_create(%s): %s\n", specs[i].name, strerror(err));
+            return -1;
+        }
+    }
+    for (int i = 0; i < NTASKS; i++) {
+        stack_task_join(&tasks[i], NULL);
+    }
+
+    printf("\nTasks (the idle row is glibc's own thread setup, TLS and descriptor):\n");
+    stack_report(stdout);
+
+    size_t given = 0, suggested = 0;
+    for (int i = 0; i < NTASKS; i++) {
+        size_t used = stack_high_water(&tasks[i]);
+        given += tasks[i].size;
+        suggested += (used + used / 4 + 1023) & ~(size_t)1023;
+    }
+    printf("\nTotal: %zu KiB reserved, %zu KiB suggested, %zu KiB reclaimable\n",
+           given / 1024, suggested / 1024, (given - suggested) / 1024);
+
+    for (int i = 0; i < NTASKS; i++) {
+        stack_task_destroy(&tasks[i]);
+    }
+    return 0;
+}
+
+int main(void) {
+    measure_functions();
+    return run_tasks() != 0;
+}
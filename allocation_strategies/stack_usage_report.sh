@@ -0,0 +1,46 @@
+#!/bin/sh
+# =============================================================================
+# Static per-function stack usage from gcc -fstack-usage
+# =============================================================================
+# Compiles the given sources with -fstack-usage into a scratch directory and
+# prints one row per function, deepest frame first. "dynamic" frames (alloca,
+# VLAs) are only a lower bound; compare them against the painted high-water
+# marks from stack_usage_demo.
+#
+#   ./stack_usage_report.sh allocation.c stack_usage_demo.c stack_usage.c
+#   CFLAGS="-Os" ./stack_usage_report.sh *.c
+set -eu
+
+if [ "$#" -eq 0 ]; then
+    echo "usage: $0 file.c..." >&2
+    exit 1
+fi
+
+CC=${CC:-gcc}
+CFLAGS=${CFLAGS:--O2}
+out=$(mktemp -d)
+trap 'rm -rf "$out"' EXIT
+
+n=0
+for src in "$@"; do
+    # Name the object after the whole path, so dir1/util.c and dir2/util.c
+    # do not overwrite each other's .su. The counter keeps names unique and
+    # stops ./ or ../ from turning them into dot files the glob below skips.
+    n=$((n + 1))
+    obj="$out/$n-$(printf '%s' "${src%.c}" | tr '/' '_').o"
+    # shellcheck disable=SC2086
+    $CC $CFLAGS -fstack-usage -c "$src" -o "$obj"
+done
+
+# Each .su line is "file:line:col:function<TAB>bytes<TAB>static|dynamic[,bounded]"
+cut -f1-3 "$out"/*.su | sort -t"$(printf '\t')" -k2,2rn | awk -F'\t' '
+    BEGIN { printf "%8s  %-16s %-24s %s\n", "bytes", "qualifier", "function", "location" }
+    {
+        n = split($1, loc, ":")
+        printf "%8d  %-16s %-24s %s:%s\n", $2, $3, loc[n], loc[1], loc[2]
+        total += $2
+        if ($3 != "static") dynamic++
+    }
+    END {
+        printf "%d functions, %d bytes of frames in total, %d not fully static\n", NR, total, dynamic
+    }'
@@ -0,0 +1,528 @@
+#define _GNU_SOURCE
+#include <getopt.h>
+#include <math.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/utsname.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench.h"
+
+#ifndef BENCH_CFLAGS
+#define BENCH_CFLAGS "unknown"
+#endif
+#ifndef BENCH_GIT
+#define BENCH_GIT "unknown"
+#endif
+
+extern const bench_def_t *const __start_bench_registry[] __attribute__((weak));
+extern const bench_def_t *const __stop_bench_registry[] __attribute__((weak));
+
+#define MAX_SAMPLES 1000
+
+typedef struct {
+    char name[96];
+    double median_ns;           // Per iteration
+    double mad_ns;
+    double min_ns;
+    uint64_t iters;             // Per sample
+    int samples;
+    uint64_t bytes_per_iter;
+} bench_result_t;
+
+typedef struct {
+    char cpu[128];
+    char kernel[160];
+    char governor[32];
+    char timestamp[32];
+    long cores;
+} machine_t;
+
+static struct {
+    int samples;
+    double min_time_ms;
+    double threshold_pct;
+    const char *json_path;
+    const char *baseline_path;
+    char **filters;
+    int filter_count;
+} opts = { 15, 20.0, 5.0, NULL, NULL, NULL, 0 };
+
+/* =============================================================================
+ * SECTION 1: Registry and machine info
+ * ============================================================================= */
+
+static int by_name(const void *a, const void *b) {
+    return strcmp((*(const bench_def_t *const *)a)->name, (*(const bench_def_t *const *)b)->name);
+}
+
+// Registry entries sorted by name, so runs and JSON files line up
+static size_t registry(const bench_def_t ***out) {
+    *out = NULL;        // Safe to free() on every path
+    if (__start_bench_registry == NULL || __stop_bench_registry == NULL) {
+        return 0;
+    }
+    size_t n = (size_t)(__stop_bench_registry - __start_bench_registry);
+    const bench_def_t **defs = malloc(n * sizeof(*defs));
+    if (defs == NULL) {
+        return 0;
+    }
+    memcpy(defs, __start_bench_registry, n * sizeof(*defs));
+    qsort(defs, n, sizeof(*defs), by_name);
+    *out = defs;
+    return n;
+}
+
+static int selected(const char *name) {
+    if (opts.filter_count == 0) {
+        return 1;
+    }
+    for (int i = 0; i < opts.filter_count; i++) {
+        if (strstr(name, opts.filters[i]) != NULL) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void read_first_line(const char *path, const char *prefix, char *out, size_t size) {
+    FILE *f = fopen(path, "r");
+    char line[256];
+    while (f != NULL && fgets(line, sizeof(line), f) != NULL) {
+        if (strncmp(line, prefix, strlen(prefix)) == 0) {
+            const char *value = line + strlen(prefix);
+            const char *colon = strchr(value, ':');
+            value = colon != NULL ? colon + 1 : value;
+            value += strspn(value, " \t");
+            snprintf(out, size, "%.*s", (int)strcspn(value, "\n"), value);
+            break;
+        }
+    }
+    if (f != NULL) {
+        fclose(f);
+    }
+}
+
+static void machine_info(machine_t *m) {
+    struct utsname u;
+    uname(&u);
+    snprintf(m->cpu, sizeof(m->cpu), "%s", u.machine);
+    read_first_line("/proc/cpuinfo", "model name", m->cpu, sizeof(m->cpu));
+    snprintf(m->kernel, sizeof(m->kernel), "%s %s", u.sysname, u.release);
+    snprintf(m->governor, sizeof(m->governor), "unknown");
+    read_first_line("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor", "", m->governor,
+                    sizeof(m->governor));
+    m->cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+    time_t now = time(NULL);
+    strftime(m->timestamp, sizeof(m->timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+}
+
+// Stay on one CPU so a migration cannot land in the middle of a sample
+static void pin_to_current_cpu(void) {
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        sched_setaffinity(0, sizeof(set), &set);
+    }
+}
+
+/* =============================================================================
+ * SECTION 2: Measurement
+ * ============================================================================= */
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double time_run(const bench_def_t *def, void *state, uint64_t iters) {
+    double t0 = now_ns();
+    uint64_t sink = def->run(state, iters);
+    double t1 = now_ns();
+    bench_use(sink);
+    return t1 - t0;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double median(double *v, int n) {
+    qsort(v, (size_t)n, sizeof(*v), cmp_double);
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+static int run_one(const bench_def_t *def, bench_result_t *res) {
+    void *state = def->setup != NULL ? def->setup() : NULL;
+    if (def->setup != NULL && state == NULL) {
+        return -1;
+    }
+
+    // Calibrate: grow iters until one sample takes min_time; this doubles
+    // as the warm-up for caches, branch predictors and page faults
+    double target = opts.min_time_ms * 1e6;
+    uint64_t iters = 1;
+    for (;;) {
+        double t = time_run(def, state, iters);
+        if (t >= target || iters >= (1ull << 40)) {
+            break;
+        }
+        double grow = t > 0 ? target * 1.1 / t : 100;
+        iters = (uint64_t)((double)iters * (grow < 2 ? 2 : grow > 100 ? 100 : grow));
+    }
+
+    double per_iter[MAX_SAMPLES], dev[MAX_SAMPLES];
+    double min = INFINITY;
+    for (int s = 0; s < opts.samples; s++) {
+        per_iter[s] = time_run(def, state, iters) / (double)iters;
+        min = per_iter[s] < min ? per_iter[s] : min;
+    }
+    double med = median(per_iter, opts.samples);
+    for (int s = 0; s < opts.samples; s++) {
+        dev[s] = fabs(per_iter[s] - med);
+    }
+
+    snprintf(res->name, sizeof(res->name), "%s", def->name);
+    res->median_ns = med;
+    res->mad_ns = median(dev, opts.samples);
+    res->min_ns = min;
+    res->iters = iters;
+    res->samples = opts.samples;
+    res->bytes_per_iter = def->bytes_per_iter;
+
+    if (def->teardown != NULL) {
+        def->teardown(state);
+    }
+    return 0;
+}
+
+static void print_result(const bench_result_t *r) {
+    double spread = r->median_ns > 0 ? 100.0 * r->mad_ns / r->median_ns : 0;
+    printf("%-40s %12.2f %7.2f%% %12.2f", r->name, r->median_ns, spread, r->min_ns);
+    if (r->bytes_per_iter != 0) {
+        printf(" %8.2f", (double)r->bytes_per_iter / r->median_ns);
+    } else {
+        printf(" %8s", "-");
+    }
+    printf("%s\n", spread > 3.0 ? "  noisy" : "");
+}
+
+/* =============================================================================
+ * SECTION 3: JSON results
+ * =============================================================================
+ * One result object per line, so the reader below can stay a line scanner.
+ * It reads files written by this program, not arbitrary JSON.
+ */
+
+static void json_string(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s != '\0'; s++) {
+        if (*s == '"' || *s == '\\') {
+            fputc('\\', f);
+        }
+        fputc((unsigned char)*s >= 0x20 ? *s : ' ', f);
+    }
+    fputc('"', f);
+}
+
+static int write_json(const char *path, const machine_t *m, const bench_result_t *res, size_t n) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    fprintf(f, "{\n  \"machine\": {\"cpu\": ");
+    json_string(f, m->cpu);
+    fprintf(f, ", \"cores\": %ld, \"kernel\": ", m->cores);
+    json_string(f, m->kernel);
+    fprintf(f, ", \"governor\": ");
+    json_string(f, m->governor);
+    fprintf(f, ", \"compiler\": ");
+    json_string(f, __VERSION__);
+    fprintf(f, ", \"cflags\": ");
+    json_string(f, BENCH_CFLAGS);
+    fprintf(f, ", \"git\": ");
+    json_string(f, BENCH_GIT);
+    fprintf(f, ", \"timestamp\": \"%s\"},\n", m->timestamp);
+    fprintf(f, "  \"config\": {\"samples\": %d, \"min_time_ms\": %.1f},\n", opts.samples, opts.min_time_ms);
+    fprintf(f, "  \"results\": [\n");
+    for (size_t i = 0; i < n; i++) {
+        fprintf(f, "    {\"name\": ");
+        json_string(f, res[i].name);
+        fprintf(f, ", \"median_ns\": %.4f, \"mad_ns\": %.4f, \"min_ns\": %.4f, \"iters\": %llu, "
+                   "\"samples\": %d, \"bytes_per_iter\": %llu}%s\n",
+                res[i].median_ns, res[i].mad_ns, res[i].min_ns, (unsigned long long)res[i].iters,
+                res[i].samples, (unsigned long long)res[i].bytes_per_iter, i + 1 < n ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    return fclose(f);
+}
+
+static int json_field(const char *line, const char *key, double *out) {
+    char pattern[40];
+    snprintf(pattern, sizeof(pattern), "\"%s\": ", key);
+    const char *p = strstr(line, pattern);
+    return p != NULL && sscanf(p + strlen(pattern), "%lf", out) == 1 ? 0 : -1;
+}
+
+static int json_string_field(const char *line, const char *key, char *out, size_t size) {
+    char pattern[40];
+    snprintf(pattern, sizeof(pattern), "\"%s\": \"", key);
+    const char *p = strstr(line, pattern);
+    if (p == NULL) {
+        return -1;
+    }
+    p += strlen(pattern);
+    size_t n = 0;
+    for (; *p != '\0' && *p != '"' && n + 1 < size; p++) {
+        if (*p == '\\' && p[1] != '\0') {
+            p++;
+        }
+        out[n++] = *p;
+    }
+    out[n] = '\0';
+    return 0;
+}
+
+/**
+ * @brief Load the results of a previous run
+ * @return Number of results, or -1 if the file cannot be read
+ */
+static int read_json(const char *path, char *cpu, size_t cpu_size, bench_result_t **out) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    size_t n = 0, cap = 64;
+    bench_result_t *res = malloc(cap * sizeof(*res));
+    char line[1024];
+    snprintf(cpu, cpu_size, "unknown");
+    while (res != NULL && fgets(line, sizeof(line), f) != NULL) {
+        if (strstr(line, "\"machine\"") != NULL) {
+            json_string_field(line, "cpu", cpu, cpu_size);
+            continue;
+        }
+        bench_result_t r = {0};
+        double iters = 0, samples = 0, bytes = 0;
+        if (json_string_field(line, "name", r.name, sizeof(r.name)) != 0 ||
+            json_field(line, "median_ns", &r.median_ns) != 0 || json_field(line, "mad_ns", &r.mad_ns) != 0) {
+            continue;
+        }
+        json_field(line, "min_ns", &r.min_ns);
+        json_field(line, "iters", &iters);
+        json_field(line, "samples", &samples);
+        json_field(line, "bytes_per_iter", &bytes);
+        r.iters = (uint64_t)iters;
+        r.samples = (int)samples;
+        r.bytes_per_iter = (uint64_t)bytes;
+        if (n == cap) {
+            bench_result_t *grown = realloc(res, 2 * cap * sizeof(*res));
+            if (grown == NULL) {
+                break;
+            }
+            res = grown;
+            cap *= 2;
+        }
+        res[n++] = r;
+    }
+    fclose(f);
+    *out = res;
+    return res != NULL ? (int)n : -1;
+}
+
+/* =============================================================================
+ * SECTION 4: Regression comparison
+ * =============================================================================
+ * A benchmark regresses when its median is more than threshold percent
+ * slower than the baseline, its fastest sample is too, and the median
+ * difference exceeds three times the combined MADs. Interference from other
+ * tenants inflates medians but rarely the minimum, so a burst of it cannot
+ * fail the check on its own; a real slowdown moves both.
+ */
+
+static int compare(const char *base_cpu, const bench_result_t *base, size_t nbase,
+                   const char *cur_cpu, const bench_result_t *cur, size_t ncur) {
+    if (strcmp(base_cpu, cur_cpu) != 0) {
+        printf("warning: baseline was measured on \"%s\", this run on \"%s\"\n", base_cpu, cur_cpu);
+    }
+    printf("%-40s %12s %12s %9s  %s\n", "benchmark", "base ns", "current ns", "change", "status");
+
+    int regressions = 0;
+    for (size_t i = 0; i < ncur; i++) {
+        const bench_result_t *b = NULL;
+        for (size_t j = 0; j < nbase && b == NULL; j++) {
+            b = strcmp(base[j].name, cur[i].name) == 0 ? &base[j] : NULL;
+        }
+        if (b == NULL) {
+            printf("%-40s %12s %12.2f %9s  new\n", cur[i].name, "-", cur[i].median_ns, "-");
+            continue;
+        }
+        if (!(b->median_ns > 0)) {
+            // Zeroed or hand-edited entry: nothing to divide by
+            printf("%-40s %12.2f %12.2f %9s  invalid baseline\n", cur[i].name, b->median_ns,
+                   cur[i].median_ns, "-");
+            continue;
+        }
+        double change = 100.0 * (cur[i].median_ns / b->median_ns - 1.0);
+        double min_change = b->min_ns > 0 ? 100.0 * (cur[i].min_ns / b->min_ns - 1.0) : change;
+        double noise = 3.0 * (b->mad_ns + cur[i].mad_ns);
+        const char *status = "ok";
+        if (change > opts.threshold_pct && min_change > opts.threshold_pct &&
+            cur[i].median_ns - b->median_ns > noise) {
+            status = "REGRESSED";
+            regressions++;
+        } else if (change < -opts.threshold_pct && min_change < -opts.threshold_pct &&
+                   b->median_ns - cur[i].median_ns > noise) {
+            status = "improved";
+        }
+        printf("%-40s %12.2f %12.2f %+8.1f%%  %s\n", cur[i].name, b->median_ns, cur[i].median_ns, change, status);
+    }
+    for (size_t j = 0; j < nbase; j++) {
+        int found = 0;
+        for (size_t i = 0; i < ncur && !found; i++) {
+            found = strcmp(base[j].name, cur[i].name) == 0;
+        }
+        if (!found && selected(base[j].name)) {
+            printf("%-40s %12.2f %12s %9s  missing\n", base[j].name, base[j].median_ns, "-", "-");
+        }
+    }
+    printf("\n%d regression%s beyond %.1f%%\n", regressions, regressions == 1 ? "" : "s", opts.threshold_pct);
+    return regressions;
+}
+
+/* =============================================================================
+ * SECTION 5: Command line
+ * ============================================================================= */
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "usage: %s [options] [filter...]\n"
+            "       %s --compare BASE.json CURRENT.json [--threshold PCT]\n"
+            "  --list             list registered benchmarks\n"
+            "  --samples N        samples per benchmark (default 15)\n"
+            "  --min-time MS      minimum duration of one sample (default 20)\n"
+            "  --json FILE        write results as JSON\n"
+            "  --baseline FILE    compare this run against FILE\n"
+            "  --threshold PCT    regression threshold in percent (default 5)\n"
+            "Filters select benchmarks whose name contains any of them.\n"
+            "Exit status is 1 if any benchmark regressed.\n",
+            argv0, argv0);
+}
+
+int main(int argc, char **argv) {
+    static const struct option longopts[] = {
+        { "list", no_argument, NULL, 'l' },
+        { "samples", required_argument, NULL, 's' },
+        { "min-time", required_argument, NULL, 't' },
+        { "json", required_argument, NULL, 'j' },
+        { "baseline", required_argument, NULL, 'b' },
+        { "threshold", required_argument, NULL, 'r' },
+        { "compare", no_argument, NULL, 'c' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, 0, NULL, 0 },
+    };
+    int list = 0, compare_only = 0, c;
+    while ((c = getopt_long(argc, argv, "", longopts, NULL)) != -1) {
+        switch (c) {
+        case 'l': list = 1; break;
+        case 's': opts.samples = atoi(optarg); break;
+        case 't': opts.min_time_ms = atof(optarg); break;
+        case 'j': opts.json_path = optarg; break;
+        case 'b': opts.baseline_path = optarg; break;
+        case 'r': opts.threshold_pct = atof(optarg); break;
+        case 'c': compare_only = 1; break;
+        default: usage(argv[0]); return c == 'h' ? 0 : 2;
+        }
+    }
+    if (opts.samples < 1 || opts.samples > MAX_SAMPLES || opts.min_time_ms <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (compare_only) {
+        if (argc - optind != 2) {
+            usage(argv[0]);
+            return 2;
+        }
+        char base_cpu[128], cur_cpu[128];
+        bench_result_t *base, *cur;
+        int nbase = read_json(argv[optind], base_cpu, sizeof(base_cpu), &base);
+        int ncur = read_json(argv[optind + 1], cur_cpu, sizeof(cur_cpu), &cur);
+        if (nbase < 0 || ncur < 0) {
+            return 2;
+        }
+        int regressions = compare(base_cpu, base, (size_t)nbase, cur_cpu, cur, (size_t)ncur);
+        free(base);
+        free(cur);
+        return regressions != 0;
+    }
+    opts.filters = argv + optind;
+    opts.filter_count = argc - optind;
+
+    const bench_def_t **defs;
+    size_t n = registry(&defs);
+    if (list) {
+        for (size_t i = 0; i < n; i++) {
+            if (selected(defs[i]->name)) {
+                printf("%s\n", defs[i]->name);
+            }
+        }
+        free(defs);
+        return 0;
+    }
+
+    machine_t m;
+    machine_info(&m);
+    pin_to_current_cpu();
+    printf("cpu: %s (%ld online), %s, governor %s\n", m.cpu, m.cores, m.kernel, m.governor);
+    printf("compiler: gcc %s, flags: %s, git %s\n", __VERSION__, BENCH_CFLAGS, BENCH_GIT);
+    printf("%d samples of at least %.0f ms each; median and MAD per iteration\n\n",
+           opts.samples, opts.min_time_ms);
+    printf("%-40s %12s %8s %12s %8s\n", "benchmark", "median ns", "MAD", "min ns", "GB/s");
+
+    bench_result_t *res = calloc(n > 0 ? n : 1, sizeof(*res));
+    size_t done = 0;
+    for (size_t i = 0; i < n && res != NULL; i++) {
+        if (!selected(defs[i]->name)) {
+            continue;
+        }
+        if (run_one(defs[i], &res[done]) != 0) {
+            printf("%-40s setup failed\n", defs[i]->name);
+            continue;
+        }
+        print_result(&res[done]);
+        fflush(stdout);
+        done++;
+    }
+    free(defs);
+
+    int status = 0;
+    if (opts.json_path != NULL && write_json(opts.json_path, &m, res, done) != 0) {
+        status = 2;
+    }
+    if (opts.baseline_path != NULL) {
+        char base_cpu[128];
+        bench_result_t *base;
+        int nbase = read_json(opts.baseline_path, base_cpu, sizeof(base_cpu), &base);
+        printf("\nAgainst %s:\n", opts.baseline_path);
+        if (nbase < 0) {
+            status = 2;
+        } else {
+            if (compare(base_cpu, base, (size_t)nbase, m.cpu, res, done) != 0 && status == 0) {
+                status = 1;
+            }
+            free(base);
+        }
+    }
+    free(res);
+    return status;
+}
@@ -0,0 +1,73 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * Benchmark Registry
+ * =============================================================================
+ * Each module file defines its benchmarks next to the code they exercise:
+ *
+ *     static uint64_t run_vector_add(void *state, uint64_t iters) {
+ *         vectors_t *v = state;
+ *         for (uint64_t i = 0; i < iters; i++) {
+ *             vector_add_restrict(v->result, v->a, v->b, v->n);
+ *             bench_clobber();
+ *         }
+ *         return v->result[0];
+ *     }
+ *     BENCH("restrict/vector_add_restrict", vectors_setup, free, run_vector_add,
+ *           4096 * 3 * sizeof(int));
+ *
+ * BENCH() places a pointer to the definition in the "bench_registry" linker
+ * section, so adding a file to the Makefile is the only registration step.
+ * The harness calibrates iters until a sample takes --min-time, then
+ * reports the median and median absolute deviation (MAD) over --samples.
+ *
+ * run() returns a value derived from its work so the compiler cannot drop
+ * it. Work that must not be hoisted out of the iteration loop goes behind
+ * bench_clobber().
+ */
+
+typedef struct {
+    const char *name;                           // "module/benchmark"
+    void *(*setup)(void);                       // May be NULL; state is passed to run()
+    void (*teardown)(void *state);              // May be NULL
+    uint64_t (*run)(void *state, uint64_t iters);
+    uint64_t bytes_per_iter;                    // For GB/s, 0 if not meaningful
+} bench_def_t;
+
+#define BENCH_CONCAT_(a, b)     a##b
+#define BENCH_CONCAT(a, b)      BENCH_CONCAT_(a, b)
+
+#define BENCH(name, setup, teardown, run, bytes_per_iter)                                   \
+    static const bench_def_t BENCH_CONCAT(bench_def_, __LINE__) =                          \
+        { name, setup, teardown, run, bytes_per_iter };                                    \
+    static const bench_def_t *const BENCH_CONCAT(bench_ptr_, __LINE__)                     \
+        __attribute__((section("bench_registry"), used)) = &BENCH_CONCAT(bench_def_, __LINE__)
+
+/**
+ * @brief Make the optimiser assume value is used
+ */
+#define bench_use(value)    __asm__ volatile("" : : "r"(value))
+
+/**
+ * @brief Make the optimiser assume all memory is read and written
+ */
+static inline void bench_clobber(void) {
+    __asm__ volatile("" : : : "memory");
+}
+
+/**
+ * @brief xorshift32, for benchmarks that need reproducible pseudo-random input
+ */
+static inline uint32_t bench_rand(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+#endif /* BENCH_H */
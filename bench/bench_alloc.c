@@ -0,0 +1,133 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+/* =============================================================================
+ * allocation_strategies/: stack, heap churn and a fixed-block pool
+ * ============================================================================= */
+
+#define LIVE_BLOCKS 256
+#define POOL_BLOCK  512
+
+// stack_allocation_example() without the printf
+static uint64_t run_stack_buffer(void *state, uint64_t iters) {
+    (void)state;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        char buffer[100];
+        strncpy(buffer, "This is stored on the stack", sizeof(buffer) - 1);
+        buffer[sizeof(buffer) - 1] = '\0';
+        bench_clobber();
+        sum += (uint8_t)buffer[i % 27];
+    }
+    return sum;
+}
+
+static uint64_t run_malloc_free_64(void *state, uint64_t iters) {
+    (void)state;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        char *p = malloc(64);
+        bench_use(p);
+        sum += (uintptr_t)p & 0xFF;
+        free(p);
+    }
+    return sum;
+}
+
+/*
+ * Churn: LIVE_BLOCKS blocks stay allocated; each iteration frees a random
+ * one and allocates 16-512 bytes in its place, the long-running version of
+ * fragmentation_demonstration().
+ */
+typedef struct {
+    void *live[LIVE_BLOCKS];
+    uint32_t seed;
+    // Fixed-block pool, used by the pool benchmark only
+    void *free_list;
+    _Alignas(16) uint8_t pool[LIVE_BLOCKS + 1][POOL_BLOCK];
+} churn_t;
+
+static void *churn_setup(void) {
+    churn_t *c = calloc(1, sizeof(*c));
+    if (c == NULL) {
+        return NULL;
+    }
+    c->seed = 0x2545F491;
+    for (int i = 0; i < LIVE_BLOCKS; i++) {
+        c->live[i] = malloc(16 + bench_rand(&c->seed) % 497);
+    }
+    return c;
+}
+
+static void churn_teardown(void *state) {
+    churn_t *c = state;
+    for (int i = 0; i < LIVE_BLOCKS; i++) {
+        free(c->live[i]);
+    }
+    free(c);
+}
+
+static uint64_t run_malloc_churn(void *state, uint64_t iters) {
+    churn_t *c = state;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        uint32_t r = bench_rand(&c->seed);
+        uint32_t slot = r % LIVE_BLOCKS;
+        size_t size = 16 + (r >> 16) % 497;
+        free(c->live[slot]);
+        c->live[slot] = malloc(size);
+        *(volatile uint8_t *)c->live[slot] = (uint8_t)i;   // Touch it, as a user would
+        sum += size;
+    }
+    return sum;
+}
+
+static void *pool_get(churn_t *c) {
+    void *block = c->free_list;
+    if (block != NULL) {
+        c->free_list = *(void **)block;
+    }
+    return block;
+}
+
+static void pool_put(churn_t *c, void *block) {
+    *(void **)block = c->free_list;
+    c->free_list = block;
+}
+
+static void *pool_setup(void) {
+    churn_t *c = calloc(1, sizeof(*c));
+    if (c == NULL) {
+        return NULL;
+    }
+    c->seed = 0x2545F491;
+    for (int i = 0; i <= LIVE_BLOCKS; i++) {
+        pool_put(c, c->pool[i]);
+    }
+    for (int i = 0; i < LIVE_BLOCKS; i++) {
+        c->live[i] = pool_get(c);
+    }
+    return c;
+}
+
+static uint64_t run_pool_churn(void *state, uint64_t iters) {
+    churn_t *c = state;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        uint32_t r = bench_rand(&c->seed);
+        uint32_t slot = r % LIVE_BLOCKS;
+        size_t size = 16 + (r >> 16) % 497;     // Any size up to POOL_BLOCK fits
+        pool_put(c, c->live[slot]);
+        c->live[slot] = pool_get(c);
+        *(volatile uint8_t *)c->live[slot] = (uint8_t)i;
+        sum += size;
+    }
+    return sum;
+}
+
+BENCH("alloc/stack_buffer_100B", NULL, NULL, run_stack_buffer, 0);
+BENCH("alloc/malloc_free_64B", NULL, NULL, run_malloc_free_64, 0);
+BENCH("alloc/malloc_churn", churn_setup, churn_teardown, run_malloc_churn, 0);
+BENCH("alloc/pool_churn", pool_setup, free, run_pool_churn, 0);
@@ -0,0 +1,79 @@
+#include <stdlib.h>
+
+#include "bench.h"
+
+/* =============================================================================
+ * mem_padding/ and pragma_pack/: what layout costs per access
+ * =============================================================================
+ * Two array sizes per comparison: one that fits in L1, where packing only
+ * adds unaligned loads, and one far larger than the caches, where the
+ * smaller struct wins by moving fewer bytes.
+ */
+
+#define SMALL_COUNT 1024
+#define LARGE_COUNT (4u << 20)
+
+// From pragma_pack/pragma_pack.c
+struct DefaultStruct {
+    char a;
+    int b;
+    char c;
+    int d;
+};
+
+#pragma pack(push, 1)
+struct PackedStruct {
+    char a;
+    int b;
+    char c;
+    int d;
+};
+#pragma pack(pop)
+
+// From mem_padding/mem_padding.c: the same fields, declared largest first
+typedef struct {
+    int b;
+    int d;
+    char a;
+    char c;
+} example_b;
+
+_Static_assert(sizeof(struct DefaultStruct) == 16 && sizeof(struct PackedStruct) == 10 &&
+               sizeof(example_b) == 12, "layouts the benchmark names assume");
+
+#define DEFINE_LAYOUT_BENCH(tag, type, count)                                               \
+    static void *tag##_setup(void) {                                                       \
+        type *v = malloc((count) * sizeof(type));                                          \
+        for (size_t i = 0; v != NULL && i < (count); i++) {                                \
+            v[i].a = (char)i;                                                              \
+            v[i].b = (int)i;                                                               \
+            v[i].c = (char)(i >> 8);                                                       \
+            v[i].d = (int)(i * 3);                                                         \
+        }                                                                                  \
+        return v;                                                                          \
+    }                                                                                      \
+    static uint64_t tag##_run(void *state, uint64_t iters) {                               \
+        type *v = state;                                                                   \
+        uint64_t sum = 0;                                                                  \
+        for (uint64_t it = 0; it < iters; it++) {                                          \
+            for (size_t i = 0; i < (count); i++) {                                         \
+                sum += (uint64_t)(v[i].b + v[i].d) + (uint64_t)v[i].c;                     \
+            }                                                                              \
+            bench_clobber();                                                               \
+        }                                                                                  \
+        return sum;                                                                        \
+    }
+
+DEFINE_LAYOUT_BENCH(aligned_l1, struct DefaultStruct, SMALL_COUNT)
+DEFINE_LAYOUT_BENCH(packed_l1, struct PackedStruct, SMALL_COUNT)
+DEFINE_LAYOUT_BENCH(reordered_l1, example_b, SMALL_COUNT)
+DEFINE_LAYOUT_BENCH(aligned_dram, struct DefaultStruct, LARGE_COUNT)
+DEFINE_LAYOUT_BENCH(packed_dram, struct PackedStruct, LARGE_COUNT)
+DEFINE_LAYOUT_BENCH(reordered_dram, example_b, LARGE_COUNT)
+
+BENCH("layout/aligned_16B_sum_l1", aligned_l1_setup, free, aligned_l1_run, SMALL_COUNT * 16);
+BENCH("layout/packed_10B_sum_l1", packed_l1_setup, free, packed_l1_run, SMALL_COUNT * 10);
+BENCH("layout/reordered_12B_sum_l1", reordered_l1_setup, free, reordered_l1_run, SMALL_COUNT * 12);
+BENCH("layout/aligned_16B_sum_dram", aligned_dram_setup, free, aligned_dram_run, LARGE_COUNT * 16ull);
+BENCH("layout/packed_10B_sum_dram", packed_dram_setup, free, packed_dram_run, LARGE_COUNT * 10ull);
+BENCH("layout/reordered_12B_sum_dram", reordered_dram_setup, free, reordered_dram_run, LARGE_COUNT * 12ull);
@@ -0,0 +1,108 @@
+#include <stdlib.h>
+
+#include "bench.h"
+
+/* =============================================================================
+ * restrict/: vector kernels with and without restrict
+ * =============================================================================
+ * The same kernels as restrict/restrict.c. noinline keeps the caller from
+ * proving the arrays distinct, which would hide what restrict buys.
+ */
+
+#define VEC_LEN 4096
+
+__attribute__((noinline))
+static void vector_add_standard(int *result, const int *a, const int *b, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        result[i] = a[i] + b[i];
+    }
+}
+
+__attribute__((noinline))
+static void vector_add_restrict(int *restrict result, const int *restrict a,
+                                const int *restrict b, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        result[i] = a[i] + b[i];
+    }
+}
+
+__attribute__((noinline))
+static void vector_scale_inplace(int *data, int scale, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        data[i] = data[i] * scale;
+    }
+}
+
+__attribute__((noinline))
+static void vector_scale_restrict(int *restrict output, const int *restrict input,
+                                  int scale, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        output[i] = input[i] * scale;
+    }
+}
+
+// The pads stop the three arrays sitting exactly 16 KiB apart, where every
+// store would 4K-alias the next iteration's loads and make timings erratic
+typedef struct {
+    int a[VEC_LEN];
+    int pad1[16];
+    int b[VEC_LEN];
+    int pad2[32];
+    int result[VEC_LEN];
+    int one;                    // Scale factor the compiler cannot see is 1
+} vectors_t;
+
+static void *vectors_setup(void) {
+    vectors_t *v = aligned_alloc(64, sizeof(vectors_t));
+    if (v != NULL) {
+        for (size_t i = 0; i < VEC_LEN; i++) {
+            v->a[i] = (int)(i % 100);
+            v->b[i] = (int)(i % 50);
+            v->result[i] = 0;
+        }
+        v->one = 1;
+    }
+    return v;
+}
+
+static uint64_t run_add_standard(void *state, uint64_t iters) {
+    vectors_t *v = state;
+    for (uint64_t i = 0; i < iters; i++) {
+        vector_add_standard(v->result, v->a, v->b, VEC_LEN);
+        bench_clobber();
+    }
+    return (uint64_t)v->result[VEC_LEN - 1];
+}
+
+static uint64_t run_add_restrict(void *state, uint64_t iters) {
+    vectors_t *v = state;
+    for (uint64_t i = 0; i < iters; i++) {
+        vector_add_restrict(v->result, v->a, v->b, VEC_LEN);
+        bench_clobber();
+    }
+    return (uint64_t)v->result[VEC_LEN - 1];
+}
+
+// Scale by 1 so repeated iterations leave the data unchanged
+static uint64_t run_scale_inplace(void *state, uint64_t iters) {
+    vectors_t *v = state;
+    for (uint64_t i = 0; i < iters; i++) {
+        vector_scale_inplace(v->a, v->one, VEC_LEN);
+        bench_clobber();
+    }
+    return (uint64_t)v->a[VEC_LEN - 1];
+}
+
+static uint64_t run_scale_restrict(void *state, uint64_t iters) {
+    vectors_t *v = state;
+    for (uint64_t i = 0; i < iters; i++) {
+        vector_scale_restrict(v->result, v->a, 3, VEC_LEN);
+        bench_clobber();
+    }
+    return (uint64_t)v->result[VEC_LEN - 1];
+}
+
+BENCH("restrict/vector_add_standard", vectors_setup, free, run_add_standard, 3 * VEC_LEN * sizeof(int));
+BENCH("restrict/vector_add_restrict", vectors_setup, free, run_add_restrict, 3 * VEC_LEN * sizeof(int));
+BENCH("restrict/vector_scale_inplace", vectors_setup, free, run_scale_inplace, 2 * VEC_LEN * sizeof(int));
+BENCH("restrict/vector_scale_restrict", vectors_setup, free, run_scale_restrict, 2 * VEC_LEN * sizeof(int));
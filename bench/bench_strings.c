@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "intern.h"
+#include "strkern.h"
+
+/* =============================================================================
+ * string_array_ptr/: string kernels and interning
+ * ============================================================================= */
+
+#define STR_LEN     256
+#define TOPICS      1024
+
+static void *string_setup(void) {
+    char *s = malloc(STR_LEN + 1);
+    if (s != NULL) {
+        memset(s, 'x', STR_LEN);
+        s[STR_LEN] = '\0';
+    }
+    return s;
+}
+
+static uint64_t run_libc_strlen(void *state, uint64_t iters) {
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        sum += strlen(state);
+        bench_clobber();
+    }
+    return sum;
+}
+
+static uint64_t run_sk_strlen(void *state, uint64_t iters) {
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        sum += sk_strlen(state);
+        bench_clobber();
+    }
+    return sum;
+}
+
+typedef struct {
+    intern_pool_t *pool;
+    char names[TOPICS][32];
+} topics_t;
+
+static void *topics_setup(void) {
+    topics_t *t = malloc(sizeof(*t));
+    if (t == NULL || (t->pool = intern_pool_create(TOPICS)) == NULL) {
+        free(t);
+        return NULL;
+    }
+    for (int i = 0; i < TOPICS; i++) {
+        snprintf(t->names[i], sizeof(t->names[i]), "sensors/zone%02d/temp%04d", i % 16, i);
+        intern_cstr(t->pool, t->names[i]);
+    }
+    return t;
+}
+
+static void topics_teardown(void *state) {
+    topics_t *t = state;
+    intern_pool_destroy(t->pool);
+    free(t);
+}
+
+// Interning a string that is already in the pool: the lock-free hit path
+static uint64_t run_intern_hit(void *state, uint64_t iters) {
+    topics_t *t = state;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        const char *h = intern_cstr(t->pool, t->names[i % TOPICS]);
+        sum += (uintptr_t)h & 0xFF;
+    }
+    return sum;
+}
+
+BENCH("strings/strlen_libc_256B", string_setup, free, run_libc_strlen, STR_LEN);
+BENCH("strings/strlen_sk_256B", string_setup, free, run_sk_strlen, STR_LEN);
+BENCH("strings/intern_hit", topics_setup, topics_teardown, run_intern_hit, 0);
@@ -0,0 +1,104 @@
+#include <stdlib.h>
+
+#include "bench.h"
+#include "crc.h"
+
+/* =============================================================================
+ * volatile/: plain vs volatile counters, register access and frame CRCs
+ * ============================================================================= */
+
+// The loop body from performance_comparison() in volatile/volatile.c
+static uint64_t run_counter_plain(void *state, uint64_t iters) {
+    (void)state;
+    uint32_t counter = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        counter++;
+        counter--;
+        counter += 2;
+        bench_use(counter);     // Keeps the loop, but counter may live in a register
+    }
+    return counter;
+}
+
+static uint64_t run_counter_volatile(void *state, uint64_t iters) {
+    (void)state;
+    volatile uint32_t counter = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        counter++;
+        counter--;
+        counter += 2;
+    }
+    return counter;
+}
+
+// A GPIO output data register, toggled with read-modify-write as in
+// gpio_port_update()
+typedef struct {
+    volatile uint32_t MODER;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+} gpio_regs_t;
+
+static void *gpio_setup(void) {
+    return calloc(1, sizeof(gpio_regs_t));
+}
+
+static uint64_t run_gpio_rmw(void *state, uint64_t iters) {
+    gpio_regs_t *gpio = state;
+    for (uint64_t i = 0; i < iters; i++) {
+        gpio->ODR |= 1u << 5;
+        gpio->ODR &= ~(1u << 5);
+    }
+    return gpio->ODR;
+}
+
+// Atomic set/reset through BSRR: one store per edge, no read
+static uint64_t run_gpio_bsrr(void *state, uint64_t iters) {
+    gpio_regs_t *gpio = state;
+    for (uint64_t i = 0; i < iters; i++) {
+        gpio->BSRR = 1u << 5;
+        gpio->BSRR = 1u << (5 + 16);
+    }
+    return gpio->BSRR;
+}
+
+#define FRAME_LEN 1500
+
+static void *frame_setup(void) {
+    uint8_t *frame = malloc(FRAME_LEN);
+    uint32_t seed = 0xC0FFEE;
+    for (size_t i = 0; frame != NULL && i < FRAME_LEN; i++) {
+        frame[i] = (uint8_t)bench_rand(&seed);
+    }
+    return frame;
+}
+
+static uint64_t run_crc(crc_algo_t algo, const void *frame, size_t len, uint64_t iters) {
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        sum += crc_compute(algo, frame, len);
+        bench_clobber();
+    }
+    return sum;
+}
+
+static uint64_t run_crc16_64(void *state, uint64_t iters) {
+    return run_crc(CRC16_CCITT_FALSE, state, 64, iters);
+}
+
+static uint64_t run_crc32_1500(void *state, uint64_t iters) {
+    return run_crc(CRC32, state, FRAME_LEN, iters);
+}
+
+static uint64_t run_crc32c_1500(void *state, uint64_t iters) {
+    return run_crc(CRC32C, state, FRAME_LEN, iters);
+}
+
+BENCH("volatile/counter_plain", NULL, NULL, run_counter_plain, 0);
+BENCH("volatile/counter_volatile", NULL, NULL, run_counter_volatile, 0);
+BENCH("volatile/gpio_odr_rmw", gpio_setup, free, run_gpio_rmw, 0);
+BENCH("volatile/gpio_bsrr_store", gpio_setup, free, run_gpio_bsrr, 0);
+BENCH("volatile/crc16_ccitt_64B", frame_setup, free, run_crc16_64, 64);
+BENCH("volatile/crc32_1500B", frame_setup, free, run_crc32_1500, FRAME_LEN);
+BENCH("volatile/crc32c_1500B", frame_setup, free, run_crc32c_1500, FRAME_LEN);
@@ -0,0 +1,101 @@
+#ifndef LAZY_ONCE_H
+#define LAZY_ONCE_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <sched.h>
+#endif
+
+/* =============================================================================
+ * Thread-Safe Lazy Initialization
+ * =============================================================================
+ * A function-local static is initialised once, but in C nothing stops two
+ * threads from running the initialisation at the same time:
+ *
+ *     static uint32_t table[256];
+ *     static bool built;           // Data race on first concurrent use
+ *     if (!built) { build(table); built = true; }
+ *
+ * lazy_once() fixes that with the cheapest possible fast path: once the
+ * initialiser has finished, every call is one acquire load and a predictable
+ * branch. Threads that arrive while initialisation is running sleep on a
+ * futex instead of spinning or taking a mutex.
+ *
+ *     static lazy_once_t once = LAZY_ONCE_INIT;
+ *     lazy_once(&once, build, table);
+ */
+
+enum {
+    LAZY_ONCE_NEW = 0,          // Nobody has started
+    LAZY_ONCE_RUNNING,          // One thread is running the initialiser
+    LAZY_ONCE_WAITING,          // ... and at least one thread sleeps on it
+    LAZY_ONCE_DONE,
+};
+
+typedef struct {
+    _Atomic uint32_t state;
+} lazy_once_t;
+
+#define LAZY_ONCE_INIT { LAZY_ONCE_NEW }
+
+static inline void lazy_once_wait(_Atomic uint32_t *addr, uint32_t expected) {
+#ifdef __linux__
+    syscall(SYS_futex, (uint32_t*)addr, FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+#else
+    (void)addr;
+    (void)expected;
+    sched_yield();
+#endif
+}
+
+static inline void lazy_once_wake_all(_Atomic uint32_t *addr) {
+#ifdef __linux__
+    syscall(SYS_futex, (uint32_t*)addr, FUTEX_WAKE_PRIVATE, INT32_MAX, NULL, NULL, 0);
+#else
+    (void)addr;
+#endif
+}
+
+/**
+ * @brief Slow path: claim the initialiser or sleep until it has finished
+ */
+static __attribute__((noinline, unused)) void lazy_once_slow(lazy_once_t *once, void (*init)(void *), void *arg) {
+    uint32_t state = LAZY_ONCE_NEW;
+
+    if (atomic_compare_exchange_strong_explicit(&once->state, &state, LAZY_ONCE_RUNNING,
+                                                memory_order_acquire, memory_order_acquire)) {
+        init(arg);
+        // Release publishes everything init() wrote to every later acquire load
+        if (atomic_exchange_explicit(&once->state, LAZY_ONCE_DONE, memory_order_release) == LAZY_ONCE_WAITING) {
+            lazy_once_wake_all(&once->state);
+        }
+        return;
+    }
+
+    while (state != LAZY_ONCE_DONE) {
+        if (state == LAZY_ONCE_RUNNING &&
+            !atomic_compare_exchange_weak_explicit(&once->state, &state, LAZY_ONCE_WAITING,
+                                                   memory_order_acquire, memory_order_acquire)) {
+            continue;       // `state` was reloaded by the failed CAS
+        }
+        lazy_once_wait(&once->state, LAZY_ONCE_WAITING);
+        state = atomic_load_explicit(&once->state, memory_order_acquire);
+    }
+}
+
+/**
+ * @brief Run init(arg) exactly once; all callers return after it has completed
+ */
+static inline void lazy_once(lazy_once_t *once, void (*init)(void *), void *arg) {
+    if (__builtin_expect(atomic_load_explicit(&once->state, memory_order_acquire) == LAZY_ONCE_DONE, 1)) {
+        return;
+    }
+    lazy_once_slow(once, init, arg);
+}
+
+#endif /* LAZY_ONCE_H */
@@ -0,0 +1,194 @@
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include <time.h>
+
+#include "lazy_once.h"
+
+/* =============================================================================
+ * A lazily built lookup table, four ways
+ * =============================================================================
+ * Each round gets a fresh once-object and table, and every implementation
+ * starts from zeroed tables and unused once-objects. All threads are released
+ * from a barrier together, so the first call really is concurrent; then
+ * every thread hammers the accessor to measure the steady-state cost.
+ */
+
+#define THREADS         8
+#define ROUNDS          32
+#define TABLE_SIZE      16384           // 64 KiB, roughly 50-100 us to build
+#define STEADY_CALLS    2000000
+
+static uint32_t tables[ROUNDS][TABLE_SIZE];
+static int current_round;               // pthread_once/call_once take no argument
+static _Atomic int init_runs;
+
+static void build_table(void *arg) {
+    uint32_t *t = arg;
+    uint32_t x = (uint32_t)(t - tables[0]) / TABLE_SIZE + 1;
+    for (uint32_t i = 0; i < TABLE_SIZE; i++) {
+        // CRC-style mixing so the build is not optimised away
+        for (int k = 0; k < 8; k++) {
+            x = (x >> 1) ^ (0xEDB88320u & -(x & 1));
+        }
+        t[i] = x ^ i;
+    }
+    atomic_fetch_add(&init_runs, 1);
+}
+
+static void build_current(void) {
+    build_table(tables[current_round]);
+}
+
+// 1. lazy_once: acquire load fast path, futex slow path
+static lazy_once_t lazy[ROUNDS];
+
+static const uint32_t *table_lazy_once(int r) {
+    lazy_once(&lazy[r], build_table, tables[r]);
+    return tables[r];
+}
+
+// 2. pthread_once
+static pthread_once_t pth_once[ROUNDS];
+
+static const uint32_t *table_pthread_once(int r) {
+    pthread_once(&pth_once[r], build_current);
+    return tables[r];
+}
+
+// 3. C11 call_once
+static once_flag c11_once[ROUNDS];
+
+static const uint32_t *table_call_once(int r) {
+    call_once(&c11_once[r], build_current);
+    return tables[r];
+}
+
+// 4. Mutex around the "already built?" check - correct but always locks
+static pthread_mutex_t table_mutex = PTHREAD_MUTEX_INITIALIZER;
+static bool mutex_built[ROUNDS];
+
+static const uint32_t *table_mutex_check(int r) {
+    pthread_mutex_lock(&table_mutex);
+    if (!mutex_built[r]) {
+        build_table(tables[r]);
+        mutex_built[r] = true;
+    }
+    pthread_mutex_unlock(&table_mutex);
+    return tables[r];
+}
+
+/* =============================================================================
+ * Harness
+ * ============================================================================= */
+
+typedef const uint32_t *(*accessor_fn)(int round);
+
+static pthread_barrier_t start_barrier;
+static pthread_barrier_t end_barrier;
+static accessor_fn accessor;
+static uint64_t first_call_ns[THREADS][ROUNDS];
+static uint64_t steady_ns[THREADS];
+static _Atomic int bad_reads;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void *bench_thread(void *arg) {
+    int id = (int)(intptr_t)arg;
+
+    for (int r = 0; r < ROUNDS; r++) {
+        if (id == 0) {
+            current_round = r;      // Ordered before every reader by the barrier
+        }
+        pthread_barrier_wait(&start_barrier);
+        uint64_t t0 = now_ns();
+        const uint32_t *t = accessor(r);
+        first_call_ns[id][r] = now_ns() - t0;
+        // A reader must never observe a half-built table
+        if (t[TABLE_SIZE - 1] == 0) {
+            atomic_fetch_add(&bad_reads, 1);
+        }
+        pthread_barrier_wait(&end_barrier);
+    }
+
+    uint32_t sum = 0;
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < STEADY_CALLS; i++) {
+        sum += accessor(ROUNDS - 1)[i & (TABLE_SIZE - 1)];
+    }
+    steady_ns[id] = now_ns() - t0;
+    return (void*)(uintptr_t)sum;
+}
+
+// Zero the tables so a torn read shows, and hand every round an unused once
+static void reset_state(void) {
+    memset(tables, 0, sizeof(tables));
+    for (int r = 0; r < ROUNDS; r++) {
+        lazy[r] = (lazy_once_t)LAZY_ONCE_INIT;
+        pth_once[r] = (pthread_once_t)PTHREAD_ONCE_INIT;
+        c11_once[r] = (once_flag)ONCE_FLAG_INIT;
+        mutex_built[r] = false;
+    }
+}
+
+static void run(const char *name, accessor_fn fn) {
+    pthread_t threads[THREADS];
+    reset_state();
+    accessor = fn;
+    atomic_store(&init_runs, 0);
+    atomic_store(&bad_reads, 0);
+
+    pthread_barrier_init(&start_barrier, NULL, THREADS);
+    pthread_barrier_init(&end_barrier, NULL, THREADS);
+    for (int i = 0; i < THREADS; i++) {
+        pthread_create(&threads[i], NULL, bench_thread, (void*)(intptr_t)i);
+    }
+    for (int i = 0; i < THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_barrier_destroy(&start_barrier);
+    pthread_barrier_destroy(&end_barrier);
+
+    // First call: slowest thread per round (everyone waits for the builder)
+    double first_avg = 0;
+    uint64_t first_max = 0;
+    for (int r = 0; r < ROUNDS; r++) {
+        uint64_t worst = 0;
+        for (int i = 0; i < THREADS; i++) {
+            worst = first_call_ns[i][r] > worst ? first_call_ns[i][r] : worst;
+        }
+        first_avg += (double)worst / ROUNDS;
+        first_max = worst > first_max ? worst : first_max;
+    }
+    double steady = 0;
+    for (int i = 0; i < THREADS; i++) {
+        steady += (double)steady_ns[i] / STEADY_CALLS / THREADS;
+    }
+
+    printf("%-16s first call %8.1f us avg %8.1f us max | steady %6.2f ns/call | inits %d/%d%s\n",
+           name, first_avg / 1000.0, (double)first_max / 1000.0, steady,
+           atomic_load(&init_runs), ROUNDS,
+           atomic_load(&bad_reads) ? "  TORN READ!" : "");
+}
+
+int main(void) {
+    printf("Lazy static initialisation: %d threads, %d rounds, %d KiB table\n\n",
+           THREADS, ROUNDS, (int)(sizeof(tables[0]) / 1024));
+
+    run("lazy_once", table_lazy_once);
+    run("pthread_once", table_pthread_once);
+    run("C11 call_once", table_call_once);
+    run("mutex + check", table_mutex_check);
+
+    printf("\nFirst call is dominated by the table build; the steady state is the\n");
+    printf("price every later call pays. 'inits' must equal the number of rounds.\n");
+    return 0;
+}
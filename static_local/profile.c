@@ -0,0 +1,187 @@
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include "profile.h"
+
+#ifndef PROFILE_DISABLE
+
+// Bounds of the call-site array assembled by the linker
+extern const profile_site_t __stop_profile_sites[] __attribute__((weak));
+
+_Thread_local profile_thread_t *profile_tls;
+volatile int profile_dump_requested;
+
+static _Atomic(profile_thread_t *) profile_threads;
+static atomic_flag exit_hook_installed = ATOMIC_FLAG_INIT;
+static atomic_flag dump_in_progress = ATOMIC_FLAG_INIT;
+
+static size_t site_count(void) {
+    if (__start_profile_sites == NULL || __stop_profile_sites == NULL) {
+        return 0;
+    }
+    return (size_t)(__stop_profile_sites - __start_profile_sites);
+}
+
+/**
+ * @brief Allocate this thread's counter block on its first profiled call
+ */
+profile_thread_t *profile_thread_attach(void) {
+    size_t n = site_count();
+    profile_thread_t *t = calloc(1, sizeof(*t) + n * sizeof(profile_counters_t));
+    if (t == NULL) {
+        return NULL;
+    }
+    t->thread_id = (uint64_t)syscall(SYS_gettid);
+    t->site_count = n;
+
+    profile_thread_t *head = atomic_load_explicit(&profile_threads, memory_order_relaxed);
+    do {
+        t->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&profile_threads, &head, t,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+
+    if (!atomic_flag_test_and_set(&exit_hook_installed)) {
+        atexit(profile_dump);
+    }
+    profile_tls = t;
+    return t;
+}
+
+static void on_dump_signal(int sig) {
+    (void)sig;
+    profile_dump_requested = 1;
+}
+
+/**
+ * @brief Print the report when `sig` arrives (at the next profiled call)
+ * @return 0 on success, -1 if the handler could not be installed
+ */
+int profile_dump_on_signal(int sig) {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_dump_signal;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    return sigaction(sig, &sa, NULL);
+}
+
+void profile_dump_pending(void) {
+    profile_dump_requested = 0;
+    profile_dump();
+}
+
+/* =============================================================================
+ * Report
+ * ============================================================================= */
+
+typedef struct {
+    const profile_site_t *site;
+    profile_counters_t total;
+    uint32_t threads;
+} site_summary_t;
+
+static double cycles_per_ns(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    struct timespec t0, t1, pause = { 0, 10 * 1000 * 1000 };
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    uint64_t c0 = profile_cycles();
+    nanosleep(&pause, NULL);
+    uint64_t c1 = profile_cycles();
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double ns = (double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec);
+    return ns > 0 ? (double)(c1 - c0) / ns : 1.0;
+#else
+    return 1.0;     // profile_cycles() already counts nanoseconds
+#endif
+}
+
+// Upper bound of the histogram bucket that holds the q-th quantile
+static uint64_t hist_quantile(const profile_counters_t *c, double q) {
+    uint64_t target = (uint64_t)((double)c->calls * q);
+    uint64_t seen = 0;
+    for (unsigned b = 0; b < PROFILE_BUCKETS; b++) {
+        seen += c->hist[b];
+        if (seen > target) {
+            return (2ull << b) - 1;
+        }
+    }
+    return c->max_cycles;
+}
+
+static int by_cycles_desc(const void *a, const void *b) {
+    const site_summary_t *x = a, *y = b;
+    return (x->total.cycles < y->total.cycles) - (x->total.cycles > y->total.cycles);
+}
+
+/**
+ * @brief Print all call sites, merged across threads, sorted by total time
+ * Counters of threads that are still running are read without
+ * synchronisation, so a concurrent dump can be off by the calls in flight.
+ */
+void profile_dump(void) {
+    if (atomic_flag_test_and_set(&dump_in_progress)) {
+        return;
+    }
+    size_t n = site_count();
+    site_summary_t *sum = calloc(n ? n : 1, sizeof(*sum));
+    if (sum == NULL) {
+        atomic_flag_clear(&dump_in_progress);
+        return;
+    }
+
+    uint32_t nthreads = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum[i].site = &__start_profile_sites[i];
+    }
+    for (profile_thread_t *t = atomic_load_explicit(&profile_threads, memory_order_acquire);
+         t != NULL; t = t->next) {
+        nthreads++;
+        for (size_t i = 0; i < t->site_count; i++) {
+            const profile_counters_t *c = &t->counters[i];
+            if (c->calls == 0) {
+                continue;
+            }
+            sum[i].threads++;
+            sum[i].total.calls += c->calls;
+            sum[i].total.cycles += c->cycles;
+            if (c->max_cycles > sum[i].total.max_cycles) {
+                sum[i].total.max_cycles = c->max_cycles;
+            }
+            for (unsigned b = 0; b < PROFILE_BUCKETS; b++) {
+                sum[i].total.hist[b] += c->hist[b];
+            }
+        }
+    }
+    qsort(sum, n, sizeof(*sum), by_cycles_desc);
+
+    double cpn = cycles_per_ns();
+    fprintf(stderr, "\n=== Profile: %zu call sites, %u threads ===\n", n, nthreads);
+    fprintf(stderr, "%-28s %12s %8s %10s %10s %10s %10s  %s\n", "Function", "Calls", "Threads",
+            "Total ms", "Avg ns", "p99 ns<=", "Max ns", "Site");
+    for (size_t i = 0; i < n; i++) {
+        const site_summary_t *s = &sum[i];
+        if (s->total.calls == 0) {
+            continue;
+        }
+        fprintf(stderr, "%-28s %12llu %8u %10.3f %10.1f %10.0f %10.0f  %s:%u\n",
+                s->site->func, (unsigned long long)s->total.calls, s->threads,
+                (double)s->total.cycles / cpn / 1e6,
+                (double)s->total.cycles / cpn / (double)s->total.calls,
+                (double)hist_quantile(&s->total, 0.99) / cpn,
+                (double)s->total.max_cycles / cpn,
+                s->site->file, s->site->line);
+    }
+    free(sum);
+    atomic_flag_clear(&dump_in_progress);
+}
+
+#endif /* PROFILE_DISABLE */
@@ -0,0 +1,137 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+/* =============================================================================
+ * Function-Level Call Count and Latency Profiler
+ * =============================================================================
+ * The grown-up version of the `static int callCount` idiom:
+ *
+ *     void countCalls(void) {
+ *         PROFILE_FN();
+ *         ...
+ *     }
+ *
+ * PROFILE_FN() defines a function-local static record, just like callCount,
+ * but places it in the "profile_sites" linker section. The linker collects
+ * every call site into one array bounded by __start_profile_sites and
+ * __stop_profile_sites, so there is no registration code and no startup cost.
+ *
+ * Counts live in per-thread blocks (allocated on a thread's first profiled
+ * call), so the hot path is a few plain increments with no atomics:
+ * one call count, a cycle total and one log2 latency histogram bucket.
+ *
+ * A sorted report is printed at exit, or after the signal installed with
+ * profile_dump_on_signal() arrives (at the next profiled call, so the dump
+ * never runs inside the signal handler).
+ *
+ * -DPROFILE_DISABLE turns PROFILE_FN() into nothing and profile.c into an
+ * empty file.
+ */
+
+#define PROFILE_BUCKETS 32      // Bucket b holds latencies in [2^b, 2^(b+1)) cycles
+
+// Size and alignment are both 32 so the linker packs the records with no gaps
+// and the section can be indexed as an array
+typedef struct {
+    const char *func;
+    const char *file;
+    uint32_t line;
+    uint32_t reserved[3];
+} __attribute__((aligned(32))) profile_site_t;
+
+_Static_assert(sizeof(profile_site_t) == 32, "profile_site_t must match its alignment");
+
+typedef struct {
+    const profile_site_t *site;
+    uint64_t start;
+} profile_scope_t;
+
+static inline uint64_t profile_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static inline profile_scope_t profile_scope_begin(const profile_site_t *site) {
+    profile_scope_t scope = { site, profile_cycles() };
+    return scope;
+}
+
+// Per-thread counters for one call site
+typedef struct {
+    uint64_t calls;
+    uint64_t cycles;
+    uint64_t max_cycles;
+    uint64_t hist[PROFILE_BUCKETS];
+} profile_counters_t;
+
+typedef struct profile_thread {
+    struct profile_thread *next;        // All thread blocks, for the report
+    uint64_t thread_id;
+    size_t site_count;
+    profile_counters_t counters[];      // Indexed like the profile_sites array
+} profile_thread_t;
+
+extern const profile_site_t __start_profile_sites[] __attribute__((weak));
+extern _Thread_local profile_thread_t *profile_tls;
+extern volatile int profile_dump_requested;
+
+profile_thread_t *profile_thread_attach(void);
+void profile_dump_pending(void);
+void profile_dump(void);
+
+/**
+ * @brief Scope-exit hook run by __attribute__((cleanup)) - the hot path
+ */
+static inline void profile_scope_end(profile_scope_t *scope) {
+    uint64_t delta = profile_cycles() - scope->start;
+    profile_thread_t *t = profile_tls;
+    if (__builtin_expect(t == NULL, 0) && (t = profile_thread_attach()) == NULL) {
+        return;
+    }
+    profile_counters_t *c = &t->counters[scope->site - __start_profile_sites];
+    unsigned bucket = 63u - (unsigned)__builtin_clzll(delta | 1);
+
+    c->calls++;
+    c->cycles += delta;
+    c->max_cycles = delta > c->max_cycles ? delta : c->max_cycles;
+    c->hist[bucket < PROFILE_BUCKETS ? bucket : PROFILE_BUCKETS - 1]++;
+
+    if (__builtin_expect(profile_dump_requested, 0)) {
+        profile_dump_pending();
+    }
+}
+
+#define PROFILE_CONCAT_(a, b)   a##b
+#define PROFILE_CONCAT(a, b)    PROFILE_CONCAT_(a, b)
+
+#ifndef PROFILE_DISABLE
+int profile_dump_on_signal(int sig);
+
+#define PROFILE_FN()                                                                    \
+    static const profile_site_t PROFILE_CONCAT(profile_site_, __LINE__)                 \
+        __attribute__((section("profile_sites"), used, aligned(32))) = { __func__, __FILE__, __LINE__, {0} }; \
+    profile_scope_t PROFILE_CONCAT(profile_scope_, __LINE__)                             \
+        __attribute__((cleanup(profile_scope_end))) =                                   \
+        profile_scope_begin(&PROFILE_CONCAT(profile_site_, __LINE__))
+#else
+#define PROFILE_FN()                    ((void)0)
+
+static inline int profile_dump_on_signal(int sig) {
+    (void)sig;
+    return 0;
+}
+#endif
+
+#endif /* PROFILE_H */
@@ -0,0 +1,249 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "intern.h"
+
+#define INTERN_CHUNK_SIZE   (64 * 1024)
+#define INTERN_MIN_SLOTS    64
+
+// Stored once per distinct string; the handle points at data[]
+typedef struct {
+    uint32_t hash;
+    uint32_t len;
+    char data[];
+} intern_entry_t;
+
+typedef struct intern_chunk {
+    struct intern_chunk *next;
+    size_t used;
+    size_t size;
+    _Alignas(8) char mem[];
+} intern_chunk_t;
+
+typedef struct intern_table {
+    struct intern_table *retired;       // Older tables, freed with the pool
+    size_t mask;
+    _Atomic(intern_entry_t *) slots[];
+} intern_table_t;
+
+struct intern_pool {
+    _Atomic(intern_table_t *) table;
+    _Atomic size_t count;
+    pthread_mutex_t write_lock;         // Serialises inserts and growth
+    intern_chunk_t *chunks;
+    size_t memory;
+};
+
+/* =============================================================================
+ * Hashing
+ * ============================================================================= */
+
+// Eight bytes per multiply-rotate step, then a final avalanche; the low bits
+// pick the slot. Every step is a bijection, so no input difference is lost.
+static uint32_t intern_hash(const char *s, size_t len) {
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ len;
+    while (len >= 8) {
+        uint64_t w;
+        memcpy(&w, s, 8);
+        h = (h ^ w) * 0xFF51AFD7ED558CCDull;
+        h = (h << 31) | (h >> 33);
+        s += 8;
+        len -= 8;
+    }
+    // 0-7 remaining bytes as at most two overlapping fixed-size loads
+    uint64_t tail = 0;
+    if (len >= 4) {
+        uint32_t lo, hi;
+        memcpy(&lo, s, 4);
+        memcpy(&hi, s + len - 4, 4);
+        tail = ((uint64_t)hi << 32) | lo;
+    } else if (len > 0) {
+        tail = ((uint64_t)(uint8_t)s[0] << 16) | ((uint64_t)(uint8_t)s[len / 2] << 8) | (uint8_t)s[len - 1];
+    }
+    h = (h ^ tail) * 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 29;
+    h *= 0xFF51AFD7ED558CCDull;
+    return (uint32_t)(h ^ (h >> 32));
+}
+
+static intern_entry_t *entry_of(const char *handle) {
+    return (intern_entry_t*)(uintptr_t)(handle - offsetof(intern_entry_t, data));
+}
+
+/* =============================================================================
+ * Arena and tables
+ * ============================================================================= */
+
+static intern_entry_t *arena_alloc(intern_pool_t *pool, size_t len) {
+    size_t need = (sizeof(intern_entry_t) + len + 1 + 7) & ~(size_t)7;
+    intern_chunk_t *c = pool->chunks;
+
+    if (c == NULL || c->size - c->used < need) {
+        size_t size = need > INTERN_CHUNK_SIZE ? need : INTERN_CHUNK_SIZE;
+        c = malloc(sizeof(*c) + size);
+        if (c == NULL) {
+            return NULL;
+        }
+        c->next = pool->chunks;
+        c->used = 0;
+        c->size = size;
+        pool->chunks = c;
+        pool->memory += sizeof(*c) + size;
+    }
+    intern_entry_t *e = (intern_entry_t*)(c->mem + c->used);
+    c->used += need;
+    return e;
+}
+
+static intern_table_t *table_alloc(intern_pool_t *pool, size_t slots) {
+    intern_table_t *t = calloc(1, sizeof(*t) + slots * sizeof(t->slots[0]));
+    if (t != NULL) {
+        t->mask = slots - 1;
+        pool->memory += sizeof(*t) + slots * sizeof(t->slots[0]);
+    }
+    return t;
+}
+
+// Linear probe for s; returns the entry or NULL, and the first empty slot seen
+static intern_entry_t *table_find(const intern_table_t *t, uint32_t hash,
+                                  const char *s, size_t len, size_t *empty_slot) {
+    for (size_t i = hash & t->mask;; i = (i + 1) & t->mask) {
+        intern_entry_t *e = atomic_load_explicit(&t->slots[i], memory_order_acquire);
+        if (e == NULL) {
+            if (empty_slot != NULL) {
+                *empty_slot = i;
+            }
+            return NULL;
+        }
+        if (e->hash == hash && e->len == len && memcmp(e->data, s, len) == 0) {
+            return e;
+        }
+    }
+}
+
+// Called with write_lock held; readers keep using the old table until the swap
+static int table_grow(intern_pool_t *pool) {
+    intern_table_t *old = atomic_load_explicit(&pool->table, memory_order_relaxed);
+    intern_table_t *t = table_alloc(pool, (old->mask + 1) * 2);
+    if (t == NULL) {
+        return -1;
+    }
+    for (size_t i = 0; i <= old->mask; i++) {
+        intern_entry_t *e = atomic_load_explicit(&old->slots[i], memory_order_relaxed);
+        if (e == NULL) {
+            continue;
+        }
+        size_t j = e->hash & t->mask;
+        while (atomic_load_explicit(&t->slots[j], memory_order_relaxed) != NULL) {
+            j = (j + 1) & t->mask;
+        }
+        atomic_store_explicit(&t->slots[j], e, memory_order_relaxed);
+    }
+    t->retired = old;
+    atomic_store_explicit(&pool->table, t, memory_order_release);
+    return 0;
+}
+
+/* =============================================================================
+ * Public API
+ * ============================================================================= */
+
+intern_pool_t *intern_pool_create(size_t expected) {
+    intern_pool_t *pool = calloc(1, sizeof(*pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    // Keep the load factor at or below 1/2 so probe sequences stay short
+    size_t slots = INTERN_MIN_SLOTS;
+    while (slots < expected * 2) {
+        slots *= 2;
+    }
+    intern_table_t *t = table_alloc(pool, slots);
+    if (t == NULL) {
+        free(pool);
+        return NULL;
+    }
+    atomic_init(&pool->table, t);
+    pthread_mutex_init(&pool->write_lock, NULL);
+    return pool;
+}
+
+void intern_pool_destroy(intern_pool_t *pool) {
+    if (pool == NULL) {
+        return;
+    }
+    intern_table_t *t = atomic_load_explicit(&pool->table, memory_order_relaxed);
+    while (t != NULL) {
+        intern_table_t *older = t->retired;
+        free(t);
+        t = older;
+    }
+    intern_chunk_t *c = pool->chunks;
+    while (c != NULL) {
+        intern_chunk_t *next = c->next;
+        free(c);
+        c = next;
+    }
+    pthread_mutex_destroy(&pool->write_lock);
+    free(pool);
+}
+
+const char *intern_lookup(const intern_pool_t *pool, const char *s, size_t len) {
+    const intern_table_t *t = atomic_load_explicit(&pool->table, memory_order_acquire);
+    intern_entry_t *e = table_find(t, intern_hash(s, len), s, len, NULL);
+    return e != NULL ? e->data : NULL;
+}
+
+const char *intern(intern_pool_t *pool, const char *s, size_t len) {
+    uint32_t hash = intern_hash(s, len);
+
+    // Fast path: already interned, no lock taken
+    const intern_table_t *t = atomic_load_explicit(&pool->table, memory_order_acquire);
+    intern_entry_t *e = table_find(t, hash, s, len, NULL);
+    if (e != NULL) {
+        return e->data;
+    }
+    if (len > UINT32_MAX) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&pool->write_lock);
+    // Re-probe the current table: another writer may have added s meanwhile
+    intern_table_t *cur = atomic_load_explicit(&pool->table, memory_order_relaxed);
+    size_t slot;
+    e = table_find(cur, hash, s, len, &slot);
+    // Never fill the last empty slot: probes for missing strings stop there
+    size_t count = atomic_load_explicit(&pool->count, memory_order_relaxed);
+    if (e == NULL && count < cur->mask && (e = arena_alloc(pool, len)) != NULL) {
+        e->hash = hash;
+        e->len = (uint32_t)len;
+        memcpy(e->data, s, len);
+        e->data[len] = '\0';
+        // Release: a reader that sees the pointer also sees the bytes
+        atomic_store_explicit(&cur->slots[slot], e, memory_order_release);
+        atomic_store_explicit(&pool->count, ++count, memory_order_relaxed);
+        if (count * 2 > cur->mask + 1) {
+            (void)table_grow(pool);     // On failure the old table just gets fuller
+        }
+    }
+    pthread_mutex_unlock(&pool->write_lock);
+    return e != NULL ? e->data : NULL;
+}
+
+const char *intern_cstr(intern_pool_t *pool, const char *s) {
+    return intern(pool, s, strlen(s));
+}
+
+size_t intern_len(const char *handle) {
+    return entry_of(handle)->len;
+}
+
+size_t intern_count(const intern_pool_t *pool) {
+    return atomic_load_explicit(&pool->count, memory_order_relaxed);
+}
+
+size_t intern_memory(const intern_pool_t *pool) {
+    return pool->memory;
+}
@@ -0,0 +1,73 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * String Interning Pool
+ * =============================================================================
+ * `char* str1 = "string"` works because the compiler stores each literal once
+ * in read-only memory. Interning does the same at run time: every distinct
+ * string is copied exactly once into immutable arena storage, and every
+ * later intern() of an equal string returns the same pointer.
+ *
+ *     const char *a = intern_cstr(pool, "sensors/b1/f2/temp");
+ *     const char *b = intern(pool, rx_buf, rx_len);
+ *     if (a == b) { ... }      // Equality is a pointer compare
+ *
+ * Handles are ordinary NUL-terminated strings, valid until the pool is
+ * destroyed, and must never be written through.
+ *
+ * Lookups are lock-free: readers probe an open-addressing table published
+ * with a release store. Inserts of new strings take a mutex. When the table
+ * grows, a new one is published and the old one is kept until the pool is
+ * destroyed, so a reader still probing it stays safe.
+ */
+
+typedef struct intern_pool intern_pool_t;
+
+/**
+ * @brief Create a pool sized for about `expected` distinct strings
+ * @return NULL if out of memory
+ */
+intern_pool_t *intern_pool_create(size_t expected);
+
+/**
+ * @brief Free the pool, its tables and every string handed out
+ */
+void intern_pool_destroy(intern_pool_t *pool);
+
+/**
+ * @brief Return the canonical copy of s[0..len), adding it if new
+ * @return Stable handle, or NULL if out of memory
+ */
+const char *intern(intern_pool_t *pool, const char *s, size_t len);
+
+/**
+ * @brief Like intern() for a NUL-terminated string
+ */
+const char *intern_cstr(intern_pool_t *pool, const char *s);
+
+/**
+ * @brief Return the canonical copy of s[0..len) without adding it
+ * @return Handle, or NULL if the string was never interned
+ */
+const char *intern_lookup(const intern_pool_t *pool, const char *s, size_t len);
+
+/**
+ * @brief Length of an interned string in O(1)
+ */
+size_t intern_len(const char *handle);
+
+/**
+ * @brief Number of distinct strings in the pool
+ */
+size_t intern_count(const intern_pool_t *pool);
+
+/**
+ * @brief Bytes held by the pool (arena chunks plus live and retired tables)
+ */
+size_t intern_memory(const intern_pool_t *pool);
+
+#endif /* INTERN_H */
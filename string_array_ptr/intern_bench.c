@@ -0,0 +1,245 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "intern.h"
+
+/* =============================================================================
+ * Workload: MQTT-style topic keys
+ * =============================================================================
+ * A few thousand topics that share long prefixes, which is the worst case
+ * for strcmp. Messages arrive in a receive buffer, so each one carries its own
+ * copy of the topic, never the canonical pointer.
+ */
+
+#define KEY_COUNT       4096
+#define MESSAGES        1000000
+#define SUBSCRIPTIONS   32
+#define READERS         4
+#define LATE_KEYS       50000
+
+static char keys[KEY_COUNT][64];
+static char *rx_topics[MESSAGES];       // Per-message copies, as received
+static const char *handles[MESSAGES];   // Same messages after interning
+
+static double seconds_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static const char *const measurements[] = {
+    "temperature", "humidity", "pressure", "co2", "battery", "rssi", "status", "firmware",
+};
+
+static void make_keys(void) {
+    for (int i = 0; i < KEY_COUNT; i++) {
+        snprintf(keys[i], sizeof(keys[i]), "site/plant-%02d/line-%02d/device-%03d/%s",
+                 i / 1024, (i / 64) % 16, (i / 8) % 64 + 100, measurements[i % 8]);
+    }
+    for (int i = 0; i < MESSAGES; i++) {
+        // Skewed: a quarter of the keys carry most of the traffic
+        uint32_t r = xorshift32();
+        int k = (r & 3) ? (int)((r >> 2) % (KEY_COUNT / 4)) : (int)((r >> 2) % KEY_COUNT);
+        rx_topics[i] = strdup(keys[k]);
+    }
+}
+
+/* =============================================================================
+ * Single-threaded comparisons
+ * ============================================================================= */
+
+static void bench_ingress(intern_pool_t *pool) {
+    size_t sink = 0;
+
+    double t0 = seconds_now();
+    for (int i = 0; i < MESSAGES; i++) {
+        char *copy = strdup(rx_topics[i]);      // Handler keeps its own copy
+        sink += (size_t)copy[5];
+        free(copy);
+    }
+    double t1 = seconds_now();
+    for (int i = 0; i < MESSAGES; i++) {
+        handles[i] = intern_cstr(pool, rx_topics[i]);
+        sink += (size_t)handles[i][5];
+    }
+    double t2 = seconds_now();
+
+    printf("Keep a copy of the topic (per message):\n");
+    printf("  strdup + free        %7.1f ns\n", (t1 - t0) * 1e9 / MESSAGES);
+    printf("  intern (hit)         %7.1f ns\n", (t2 - t1) * 1e9 / MESSAGES);
+    if (sink == 0) {
+        printf("  (sink)\n");
+    }
+}
+
+static void bench_equality(void) {
+    long equal_str = 0, equal_ptr = 0;
+
+    double t0 = seconds_now();
+    for (int i = 1; i < MESSAGES; i++) {
+        equal_str += strcmp(rx_topics[i], rx_topics[i - 1]) == 0;
+    }
+    double t1 = seconds_now();
+    for (int i = 1; i < MESSAGES; i++) {
+        const char *volatile a = handles[i];    // Keep the compiler honest
+        equal_ptr += a == handles[i - 1];
+    }
+    double t2 = seconds_now();
+
+    printf("\nEquality of consecutive topics:\n");
+    printf("  strcmp               %7.2f ns\n", (t1 - t0) * 1e9 / MESSAGES);
+    printf("  handle ==            %7.2f ns   (%s)\n", (t2 - t1) * 1e9 / MESSAGES,
+           equal_str == equal_ptr ? "same answers" : "MISMATCH");
+}
+
+static void bench_dispatch(intern_pool_t *pool) {
+    const char *sub_str[SUBSCRIPTIONS];
+    const char *sub_handle[SUBSCRIPTIONS];
+    for (int s = 0; s < SUBSCRIPTIONS; s++) {
+        sub_str[s] = keys[s * 37 % (KEY_COUNT / 4)];
+        sub_handle[s] = intern_cstr(pool, sub_str[s]);
+    }
+    long hits_str = 0, hits_ptr = 0;
+
+    double t0 = seconds_now();
+    for (int i = 0; i < MESSAGES; i++) {
+        for (int s = 0; s < SUBSCRIPTIONS; s++) {
+            if (strcmp(rx_topics[i], sub_str[s]) == 0) {
+                hits_str++;
+                break;
+            }
+        }
+    }
+    double t1 = seconds_now();
+    for (int i = 0; i < MESSAGES; i++) {
+        for (int s = 0; s < SUBSCRIPTIONS; s++) {
+            if (handles[i] == sub_handle[s]) {
+                hits_ptr++;
+                break;
+            }
+        }
+    }
+    double t2 = seconds_now();
+
+    printf("\nMatch against %d subscriptions (per message):\n", SUBSCRIPTIONS);
+    printf("  strcmp loop          %7.1f ns\n", (t1 - t0) * 1e9 / MESSAGES);
+    printf("  handle loop          %7.1f ns   (%s, %ld hits)\n", (t2 - t1) * 1e9 / MESSAGES,
+           hits_str == hits_ptr ? "same answers" : "MISMATCH", hits_ptr);
+}
+
+/* =============================================================================
+ * Concurrent read-mostly use
+ * =============================================================================
+ * Readers intern existing keys and check they always get the same pointer,
+ * while a writer keeps adding new keys and forcing the table to grow.
+ */
+
+static intern_pool_t *shared_pool;
+static const char *expected[KEY_COUNT];
+static atomic_bool writer_done;
+static atomic_long reader_errors;
+static atomic_long reader_calls;
+
+static void *reader_thread(void *arg) {
+    uint32_t x = (uint32_t)(uintptr_t)arg * 2654435761u + 1;
+    long calls = 0;
+    while (!atomic_load_explicit(&writer_done, memory_order_relaxed)) {
+        for (int i = 0; i < 1000; i++) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            int k = (int)(x % KEY_COUNT);
+            if (intern_cstr(shared_pool, keys[k]) != expected[k] ||
+                intern_lookup(shared_pool, keys[k], strlen(keys[k])) != expected[k]) {
+                atomic_fetch_add(&reader_errors, 1);
+            }
+        }
+        calls += 2000;
+    }
+    atomic_fetch_add(&reader_calls, calls);
+    return NULL;
+}
+
+static void bench_concurrent(void) {
+    shared_pool = intern_pool_create(64);       // Small on purpose: growth under load
+    for (int k = 0; k < KEY_COUNT; k++) {
+        expected[k] = intern_cstr(shared_pool, keys[k]);
+    }
+
+    pthread_t readers[READERS];
+    for (int i = 0; i < READERS; i++) {
+        pthread_create(&readers[i], NULL, reader_thread, (void*)(uintptr_t)(i + 1));
+    }
+
+    static char late[LATE_KEYS][32];
+    static const char *late_handle[LATE_KEYS];
+    double t0 = seconds_now();
+    for (int i = 0; i < LATE_KEYS; i++) {
+        snprintf(late[i], sizeof(late[i]), "late/session-%06d", i);
+        late_handle[i] = intern_cstr(shared_pool, late[i]);
+    }
+    double t1 = seconds_now();
+    atomic_store(&writer_done, true);
+    for (int i = 0; i < READERS; i++) {
+        pthread_join(readers[i], NULL);
+    }
+
+    long late_errors = 0;
+    for (int i = 0; i < LATE_KEYS; i++) {
+        late_errors += intern_cstr(shared_pool, late[i]) != late_handle[i] ||
+                       strcmp(late_handle[i], late[i]) != 0 ||
+                       intern_len(late_handle[i]) != strlen(late[i]);
+    }
+
+    printf("\nConcurrent: %d readers vs 1 writer adding %d keys (table grows from 64 slots):\n",
+           READERS, LATE_KEYS);
+    printf("  writer               %7.1f ns per new key\n", (t1 - t0) * 1e9 / LATE_KEYS);
+    printf("  reader calls         %ld, wrong handles: %ld\n",
+           atomic_load(&reader_calls), atomic_load(&reader_errors));
+    printf("  late keys re-checked %d, errors: %ld\n", LATE_KEYS, late_errors);
+    printf("  pool                 %zu strings, %zu KiB\n",
+           intern_count(shared_pool), intern_memory(shared_pool) / 1024);
+    intern_pool_destroy(shared_pool);
+}
+
+int main(void) {
+    make_keys();
+    intern_pool_t *pool = intern_pool_create(KEY_COUNT);
+
+    printf("String interning: %d distinct topics, %d messages\n\n", KEY_COUNT, MESSAGES);
+    bench_ingress(pool);
+    bench_equality();
+    bench_dispatch(pool);
+
+    size_t dup_bytes = 0;
+    for (int i = 0; i < MESSAGES; i++) {
+        dup_bytes += strlen(rx_topics[i]) + 1;
+    }
+    printf("\nStorage for every message's topic:\n");
+    printf("  strdup copies        %7zu KiB (+ malloc headers)\n", dup_bytes / 1024);
+    printf("  intern pool          %7zu KiB for %zu strings\n",
+           intern_memory(pool) / 1024, intern_count(pool));
+    intern_pool_destroy(pool);
+
+    bench_concurrent();
+
+    for (int i = 0; i < MESSAGES; i++) {
+        free(rx_topics[i]);
+    }
+    return 0;
+}
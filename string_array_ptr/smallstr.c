@@ -0,0 +1,164 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "smallstr.h"
+
+struct str_chunk {
+    str_chunk_t *next;
+    size_t used;
+    size_t size;
+    char mem[];
+};
+
+/* =============================================================================
+ * Arena
+ * ============================================================================= */
+
+void str_arena_init(str_arena_t *arena, size_t chunk_size) {
+    arena->chunks = NULL;
+    arena->chunk_size = chunk_size;
+    arena->chunk_allocs = 0;
+    arena->bytes_used = 0;
+}
+
+void str_arena_reset(str_arena_t *arena) {
+    str_chunk_t *keep = arena->chunks;
+    if (keep == NULL) {
+        return;
+    }
+    str_chunk_t *c = keep->next;
+    while (c != NULL) {
+        str_chunk_t *next = c->next;
+        free(c);
+        c = next;
+    }
+    keep->next = NULL;
+    keep->used = 0;
+    arena->bytes_used = 0;
+}
+
+void str_arena_free(str_arena_t *arena) {
+    str_arena_reset(arena);
+    free(arena->chunks);
+    arena->chunks = NULL;
+}
+
+static char *arena_alloc(str_arena_t *arena, size_t n) {
+    str_chunk_t *head = arena->chunks;
+    if (head != NULL && head->size - head->used >= n) {
+        char *p = head->mem + head->used;
+        head->used += n;
+        arena->bytes_used += n;
+        return p;
+    }
+
+    // Oversized requests get a chunk of their own behind the head, so the
+    // head's remaining space is not thrown away
+    size_t size = n > arena->chunk_size ? n : arena->chunk_size;
+    str_chunk_t *c = malloc(sizeof(*c) + size);
+    if (c == NULL) {
+        return NULL;
+    }
+    arena->chunk_allocs++;
+    c->size = size;
+    c->used = n;
+    if (size > arena->chunk_size && head != NULL) {
+        c->next = head->next;
+        head->next = c;
+    } else {
+        c->next = head;
+        arena->chunks = c;
+    }
+    arena->bytes_used += n;
+    return c->mem;
+}
+
+/* =============================================================================
+ * smallstr_t
+ * ============================================================================= */
+
+// Move s to a new arena block of at least `need` bytes holding old + extra
+static int spill(smallstr_t *s, size_t need, strview_t extra, str_arena_t *arena) {
+    size_t old_len = ss_len(s);
+    size_t cap = old_len * 2 > need ? old_len * 2 : need;
+    cap = cap < 32 ? 32 : cap;
+    if (cap > UINT32_MAX - 1) {
+        return -1;
+    }
+    char *p = arena_alloc(arena, cap + 1);
+    if (p == NULL) {
+        return -1;
+    }
+    // Copy before writing s->big: the old bytes may be in s->small.buf,
+    // and `extra` may point into them
+    memcpy(p, ss_cstr(s), old_len);
+    memcpy(p + old_len, extra.ptr, extra.len);
+    p[old_len + extra.len] = '\0';
+
+    s->big.ptr = p;
+    s->big.len = (uint32_t)(old_len + extra.len);
+    s->big.cap = (uint32_t)cap;
+    s->small.len = SMALLSTR_SPILLED;
+    return 0;
+}
+
+int ss_assign(smallstr_t *s, strview_t v, str_arena_t *arena) {
+    if (v.len <= SMALLSTR_INLINE_MAX) {
+        memmove(s->small.buf, v.ptr, v.len);
+        s->small.buf[v.len] = '\0';
+        s->small.len = (uint8_t)v.len;
+        return 0;
+    }
+    if (!ss_is_inline(s) && v.len <= s->big.cap) {
+        memmove(s->big.ptr, v.ptr, v.len);
+        s->big.ptr[v.len] = '\0';
+        s->big.len = (uint32_t)v.len;
+        return 0;
+    }
+    smallstr_t empty;
+    ss_init(&empty);
+    if (spill(&empty, v.len, v, arena) != 0) {
+        return -1;
+    }
+    *s = empty;
+    return 0;
+}
+
+int ss_append(smallstr_t *s, strview_t v, str_arena_t *arena) {
+    size_t len = ss_len(s);
+    size_t new_len = len + v.len;
+
+    if (ss_is_inline(s)) {
+        if (new_len <= SMALLSTR_INLINE_MAX) {
+            memmove(s->small.buf + len, v.ptr, v.len);
+            s->small.buf[new_len] = '\0';
+            s->small.len = (uint8_t)new_len;
+            return 0;
+        }
+    } else if (new_len <= s->big.cap) {
+        memmove(s->big.ptr + len, v.ptr, v.len);
+        s->big.ptr[new_len] = '\0';
+        s->big.len = (uint32_t)new_len;
+        return 0;
+    }
+    return spill(s, new_len, v, arena);
+}
+
+int ss_append_char(smallstr_t *s, char c, str_arena_t *arena) {
+    return ss_append(s, sv_make(&c, 1), arena);
+}
+
+int ss_append_long(smallstr_t *s, long value, str_arena_t *arena) {
+    char digits[24];
+    char *p = digits + sizeof(digits);
+    unsigned long u = value < 0 ? 0ul - (unsigned long)value : (unsigned long)value;
+
+    do {
+        *--p = (char)('0' + u % 10);
+        u /= 10;
+    } while (u != 0);
+    if (value < 0) {
+        *--p = '-';
+    }
+    return ss_append(s, sv_make(p, (size_t)(digits + sizeof(digits) - p)), arena);
+}
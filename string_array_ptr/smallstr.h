@@ -0,0 +1,106 @@
+#ifndef SMALLSTR_H
+#define SMALLSTR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "strview.h"
+
+/* =============================================================================
+ * Small-String-Optimised Owned String
+ * =============================================================================
+ * `char str2[] = "string"` owns its bytes but has a fixed size; strdup()
+ * owns them too but costs a heap allocation even for "ok". smallstr_t is
+ * 24 bytes that hold up to 22 characters (plus NUL) inline. Longer strings
+ * spill to a str_arena_t, a chunked bump allocator that is released all at
+ * once - typically per message or per request.
+ *
+ *     str_arena_t arena;
+ *     str_arena_init(&arena, 4096);
+ *     smallstr_t unit;
+ *     ss_init(&unit);
+ *     ss_assign(&unit, field, &arena);    // "degC": inline, no allocation
+ *     ...
+ *     str_arena_reset(&arena);            // Drops every spilled string at once
+ *
+ * smallstr_t has no destructor: inline strings need none and spilled ones
+ * belong to the arena. Growing a spilled string abandons its old arena copy.
+ */
+
+#define SMALLSTR_INLINE_MAX 22
+#define SMALLSTR_SPILLED    0xFF
+
+typedef struct str_chunk str_chunk_t;
+
+typedef struct {
+    str_chunk_t *chunks;        // Newest first; only the head has free space
+    size_t chunk_size;
+    size_t chunk_allocs;        // malloc() calls made, for statistics
+    size_t bytes_used;
+} str_arena_t;
+
+typedef union {
+    struct {
+        char buf[SMALLSTR_INLINE_MAX + 1];
+        uint8_t len;            // Inline length, or SMALLSTR_SPILLED
+    } small;
+    struct {
+        char *ptr;
+        uint32_t len;
+        uint32_t cap;           // Usable bytes at ptr, excluding the NUL
+    } big;                      // Overlays small.buf only; small.len stays the tag
+} smallstr_t;
+
+_Static_assert(sizeof(smallstr_t) == 24, "smallstr_t should stay three words");
+
+void str_arena_init(str_arena_t *arena, size_t chunk_size);
+
+/**
+ * @brief Forget every string allocated so far but keep the newest chunk
+ */
+void str_arena_reset(str_arena_t *arena);
+
+void str_arena_free(str_arena_t *arena);
+
+static inline void ss_init(smallstr_t *s) {
+    s->small.buf[0] = '\0';
+    s->small.len = 0;
+}
+
+static inline bool ss_is_inline(const smallstr_t *s) {
+    return s->small.len != SMALLSTR_SPILLED;
+}
+
+static inline size_t ss_len(const smallstr_t *s) {
+    return ss_is_inline(s) ? s->small.len : s->big.len;
+}
+
+static inline const char *ss_cstr(const smallstr_t *s) {
+    return ss_is_inline(s) ? s->small.buf : s->big.ptr;
+}
+
+static inline strview_t ss_view(const smallstr_t *s) {
+    return sv_make(ss_cstr(s), ss_len(s));
+}
+
+/**
+ * @brief Replace the contents of s with v
+ * @return 0 on success, -1 if the arena could not grow (s is unchanged)
+ */
+int ss_assign(smallstr_t *s, strview_t v, str_arena_t *arena);
+
+/**
+ * @brief Append v to s, spilling to the arena when it outgrows the inline buffer
+ * @return 0 on success, -1 if the arena could not grow (s is unchanged)
+ */
+int ss_append(smallstr_t *s, strview_t v, str_arena_t *arena);
+
+int ss_append_char(smallstr_t *s, char c, str_arena_t *arena);
+
+/**
+ * @brief Append a decimal integer without going through snprintf()
+ */
+int ss_append_long(smallstr_t *s, long value, str_arena_t *arena);
+
+#endif /* SMALLSTR_H */
@@ -0,0 +1,552 @@
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "strkern.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SK_X86 1
+#include <immintrin.h>
+#else
+#define SK_X86 0
+#endif
+
+#define SK_PAGE_SIZE 4096u
+
+typedef struct {
+    size_t (*strlen)(const char *s);
+    bool (*streq)(const char *a, const char *b);
+    bool (*has_prefix)(const char *s, const char *prefix);
+    const char *(*memchr)(const char *s, int c, size_t n);
+    bool (*is_ascii)(const char *s, size_t n);
+    bool (*utf8_valid)(const char *s, size_t n);
+} sk_ops_t;
+
+/* =============================================================================
+ * SECTION 1: Scalar reference implementations
+ * =============================================================================
+ * Also the ground truth for the fuzz tests, so they stay byte-at-a-time.
+ * no-tree-loop-distribute-patterns stops GCC from turning the loops back
+ * into libc calls.
+ */
+
+#define SK_SCALAR_FN __attribute__((optimize("no-tree-loop-distribute-patterns")))
+
+SK_SCALAR_FN static size_t strlen_scalar(const char *s) {
+    const char *p = s;
+    while (*p) {
+        p++;
+    }
+    return (size_t)(p - s);
+}
+
+SK_SCALAR_FN static bool streq_scalar(const char *a, const char *b) {
+    while (*a && *a == *b) {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+SK_SCALAR_FN static bool has_prefix_scalar(const char *s, const char *prefix) {
+    for (; *prefix; s++, prefix++) {
+        if (*s != *prefix) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SK_SCALAR_FN static const char *memchr_scalar(const char *s, int c, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (s[i] == (char)c) {
+            return s + i;
+        }
+    }
+    return NULL;
+}
+
+SK_SCALAR_FN static bool is_ascii_scalar(const char *s, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if ((unsigned char)s[i] & 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Length of the well-formed UTF-8 sequence at s, or 0 if it is invalid
+ */
+static inline size_t utf8_sequence(const unsigned char *s, size_t n) {
+    unsigned char c = s[0];
+
+    if (c < 0x80) {
+        return 1;
+    }
+    if (c < 0xC2) {                 // Stray continuation byte or overlong 2-byte form
+        return 0;
+    }
+    if (c < 0xE0) {
+        return (n >= 2 && (s[1] & 0xC0) == 0x80) ? 2 : 0;
+    }
+    if (c < 0xF0) {
+        if (n < 3 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80) {
+            return 0;
+        }
+        if ((c == 0xE0 && s[1] < 0xA0) ||       // Overlong
+            (c == 0xED && s[1] > 0x9F)) {       // UTF-16 surrogate
+            return 0;
+        }
+        return 3;
+    }
+    if (c < 0xF5) {
+        if (n < 4 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80 || (s[3] & 0xC0) != 0x80) {
+            return 0;
+        }
+        if ((c == 0xF0 && s[1] < 0x90) ||       // Overlong
+            (c == 0xF4 && s[1] > 0x8F)) {       // Above U+10FFFF
+            return 0;
+        }
+        return 4;
+    }
+    return 0;
+}
+
+static bool utf8_valid_scalar(const char *s, size_t n) {
+    const unsigned char *u = (const unsigned char*)s;
+    size_t i = 0;
+    while (i < n) {
+        size_t len = utf8_sequence(u + i, n - i);
+        if (len == 0) {
+            return false;
+        }
+        i += len;
+    }
+    return true;
+}
+
+static const sk_ops_t sk_ops_scalar = {
+    strlen_scalar, streq_scalar, has_prefix_scalar,
+    memchr_scalar, is_ascii_scalar, utf8_valid_scalar,
+};
+
+#if SK_X86
+
+/* =============================================================================
+ * SECTION 2: Shared helpers for the vector kernels
+ * ============================================================================= */
+
+// True if an unaligned w-byte load at p would touch the next page
+static inline bool crosses_page(const char *p, size_t w) {
+    return ((uintptr_t)p & (SK_PAGE_SIZE - 1)) > SK_PAGE_SIZE - w;
+}
+
+// Mask of the first n lanes (n < 32)
+static inline uint32_t first_lanes(size_t n) {
+    return (1u << n) - 1;
+}
+
+// Decision for a block of streq/has_prefix: `ne` = lanes that differ,
+// `end` = lanes where the terminating string has its NUL
+static inline int block_verdict_streq(uint32_t ne, uint32_t end) {
+    uint32_t stop = ne | end;
+    if (stop == 0) {
+        return -1;                      // Keep going
+    }
+    return (ne & (stop & -stop)) == 0;  // First stop is a shared NUL -> equal
+}
+
+static inline int block_verdict_prefix(uint32_t ne, uint32_t end) {
+    uint32_t stop = ne | end;
+    if (stop == 0) {
+        return -1;
+    }
+    return (end & (stop & -stop)) != 0; // Prefix ended before the first mismatch
+}
+
+// The w bytes around a page crossing, one at a time (-1: no decision yet)
+static int streq_bytes(const char *a, const char *b, size_t w) {
+    for (size_t i = 0; i < w; i++) {
+        if (a[i] != b[i]) {
+            return 0;
+        }
+        if (a[i] == '\0') {
+            return 1;
+        }
+    }
+    return -1;
+}
+
+static int prefix_bytes(const char *s, const char *prefix, size_t w) {
+    for (size_t i = 0; i < w; i++) {
+        if (prefix[i] == '\0') {
+            return 1;
+        }
+        if (s[i] != prefix[i]) {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/* =============================================================================
+ * SECTION 3: SSE2 (16 bytes per step)
+ * ============================================================================= */
+
+#define SK_SSE2_FN __attribute__((target("sse2")))
+
+SK_SSE2_FN static uint32_t mask_sse2(__m128i v) {
+    return (uint32_t)_mm_movemask_epi8(v);
+}
+
+// Aligned loads only: the first block is masked to drop bytes before s
+SK_SSE2_FN static size_t strlen_sse2(const char *s) {
+    size_t off = (uintptr_t)s & 15;
+    const char *p = s - off;
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t m = mask_sse2(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)p), zero)) >> off;
+    if (m) {
+        return __builtin_ctz(m);
+    }
+    for (;;) {
+        p += 16;
+        m = mask_sse2(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)p), zero));
+        if (m) {
+            return (size_t)(p - s) + __builtin_ctz(m);
+        }
+    }
+}
+
+SK_SSE2_FN static bool streq_sse2(const char *a, const char *b) {
+    const __m128i zero = _mm_setzero_si128();
+    for (;; a += 16, b += 16) {
+        int verdict;
+        if (crosses_page(a, 16) || crosses_page(b, 16)) {
+            verdict = streq_bytes(a, b, 16);
+        } else {
+            __m128i va = _mm_loadu_si128((const __m128i*)a);
+            __m128i vb = _mm_loadu_si128((const __m128i*)b);
+            verdict = block_verdict_streq(~mask_sse2(_mm_cmpeq_epi8(va, vb)) & 0xFFFF,
+                                          mask_sse2(_mm_cmpeq_epi8(va, zero)));
+        }
+        if (verdict >= 0) {
+            return verdict;
+        }
+    }
+}
+
+SK_SSE2_FN static bool has_prefix_sse2(const char *s, const char *prefix) {
+    const __m128i zero = _mm_setzero_si128();
+    for (;; s += 16, prefix += 16) {
+        int verdict;
+        if (crosses_page(s, 16) || crosses_page(prefix, 16)) {
+            verdict = prefix_bytes(s, prefix, 16);
+        } else {
+            __m128i vs = _mm_loadu_si128((const __m128i*)s);
+            __m128i vp = _mm_loadu_si128((const __m128i*)prefix);
+            verdict = block_verdict_prefix(~mask_sse2(_mm_cmpeq_epi8(vs, vp)) & 0xFFFF,
+                                           mask_sse2(_mm_cmpeq_epi8(vp, zero)));
+        }
+        if (verdict >= 0) {
+            return verdict;
+        }
+    }
+}
+
+// Aligned window: mask off lanes before s and at/after s + n
+SK_SSE2_FN static const char *memchr_sse2(const char *s, int c, size_t n) {
+    if (n == 0) {
+        return NULL;
+    }
+    size_t off = (uintptr_t)s & 15;
+    const char *p = s - off;
+    // Saturate: memchr(s, c, SIZE_MAX) is valid when c is known to occur
+    size_t avail = n > SIZE_MAX - off ? SIZE_MAX : n + off;
+    const __m128i vc = _mm_set1_epi8((char)c);
+    uint32_t m = mask_sse2(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)p), vc)) & (~0u << off);
+    for (;;) {
+        if (avail <= 16) {
+            m &= first_lanes(avail);
+            return m ? p + __builtin_ctz(m) : NULL;
+        }
+        if (m) {
+            return p + __builtin_ctz(m);
+        }
+        p += 16;
+        avail -= 16;
+        m = mask_sse2(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)p), vc));
+    }
+}
+
+// movemask collects the top bit of every byte: non-zero means non-ASCII
+SK_SSE2_FN static bool is_ascii_sse2(const char *s, size_t n) {
+    if (n == 0) {
+        return true;
+    }
+    size_t off = (uintptr_t)s & 15;
+    const char *p = s - off;
+    size_t avail = n > SIZE_MAX - off ? SIZE_MAX : n + off;
+    uint32_t m = mask_sse2(_mm_load_si128((const __m128i*)p)) & (~0u << off);
+    for (;;) {
+        if (avail <= 16) {
+            return (m & first_lanes(avail)) == 0;
+        }
+        if (m) {
+            return false;
+        }
+        p += 16;
+        avail -= 16;
+        m = mask_sse2(_mm_load_si128((const __m128i*)p));
+    }
+}
+
+// Skip all-ASCII blocks with one load each; decode the rest sequence by sequence
+SK_SSE2_FN static bool utf8_valid_sse2(const char *s, size_t n) {
+    const unsigned char *u = (const unsigned char*)s;
+    size_t i = 0;
+    while (i < n) {
+        if (n - i >= 16) {
+            if (mask_sse2(_mm_loadu_si128((const __m128i*)(u + i))) == 0) {
+                i += 16;
+                continue;
+            }
+        } else if (is_ascii_sse2(s + i, n - i)) {
+            return true;            // Short ASCII tail: one masked aligned load
+        }
+        // Scalar until past this block, then try the vector path again
+        size_t block_end = i + 16 < n ? i + 16 : n;
+        while (i < block_end) {
+            size_t len = utf8_sequence(u + i, n - i);
+            if (len == 0) {
+                return false;
+            }
+            i += len;
+        }
+    }
+    return true;
+}
+
+static const sk_ops_t sk_ops_sse2 = {
+    strlen_sse2, streq_sse2, has_prefix_sse2,
+    memchr_sse2, is_ascii_sse2, utf8_valid_sse2,
+};
+
+/* =============================================================================
+ * SECTION 4: AVX2 (32 bytes per step)
+ * ============================================================================= */
+
+#define SK_AVX2_FN __attribute__((target("avx2")))
+
+SK_AVX2_FN static uint32_t mask_avx2(__m256i v) {
+    return (uint32_t)_mm256_movemask_epi8(v);
+}
+
+SK_AVX2_FN static size_t strlen_avx2(const char *s) {
+    size_t off = (uintptr_t)s & 31;
+    const char *p = s - off;
+    const __m256i zero = _mm256_setzero_si256();
+    uint32_t m = mask_avx2(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)p), zero)) >> off;
+    if (m) {
+        return __builtin_ctz(m);
+    }
+    for (;;) {
+        p += 32;
+        m = mask_avx2(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)p), zero));
+        if (m) {
+            return (size_t)(p - s) + __builtin_ctz(m);
+        }
+    }
+}
+
+SK_AVX2_FN static bool streq_avx2(const char *a, const char *b) {
+    const __m256i zero = _mm256_setzero_si256();
+    for (;; a += 32, b += 32) {
+        int verdict;
+        if (crosses_page(a, 32) || crosses_page(b, 32)) {
+            verdict = streq_bytes(a, b, 32);
+        } else {
+            __m256i va = _mm256_loadu_si256((const __m256i*)a);
+            __m256i vb = _mm256_loadu_si256((const __m256i*)b);
+            verdict = block_verdict_streq(~mask_avx2(_mm256_cmpeq_epi8(va, vb)),
+                                          mask_avx2(_mm256_cmpeq_epi8(va, zero)));
+        }
+        if (verdict >= 0) {
+            return verdict;
+        }
+    }
+}
+
+SK_AVX2_FN static bool has_prefix_avx2(const char *s, const char *prefix) {
+    const __m256i zero = _mm256_setzero_si256();
+    for (;; s += 32, prefix += 32) {
+        int verdict;
+        if (crosses_page(s, 32) || crosses_page(prefix, 32)) {
+            verdict = prefix_bytes(s, prefix, 32);
+        } else {
+            __m256i vs = _mm256_loadu_si256((const __m256i*)s);
+            __m256i vp = _mm256_loadu_si256((const __m256i*)prefix);
+            verdict = block_verdict_prefix(~mask_avx2(_mm256_cmpeq_epi8(vs, vp)),
+                                           mask_avx2(_mm256_cmpeq_epi8(vp, zero)));
+        }
+        if (verdict >= 0) {
+            return verdict;
+        }
+    }
+}
+
+SK_AVX2_FN static const char *memchr_avx2(const char *s, int c, size_t n) {
+    if (n == 0) {
+        return NULL;
+    }
+    size_t off = (uintptr_t)s & 31;
+    const char *p = s - off;
+    size_t avail = n > SIZE_MAX - off ? SIZE_MAX : n + off;
+    const __m256i vc = _mm256_set1_epi8((char)c);
+    uint32_t m = mask_avx2(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)p), vc)) & (~0u << off);
+    for (;;) {
+        if (avail <= 32) {
+            if (avail < 32) {
+                m &= first_lanes(avail);
+            }
+            return m ? p + __builtin_ctz(m) : NULL;
+        }
+        if (m) {
+            return p + __builtin_ctz(m);
+        }
+        p += 32;
+        avail -= 32;
+        m = mask_avx2(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)p), vc));
+    }
+}
+
+SK_AVX2_FN static bool is_ascii_avx2(const char *s, size_t n) {
+    if (n == 0) {
+        return true;
+    }
+    size_t off = (uintptr_t)s & 31;
+    const char *p = s - off;
+    size_t avail = n > SIZE_MAX - off ? SIZE_MAX : n + off;
+    uint32_t m = mask_avx2(_mm256_load_si256((const __m256i*)p)) & (~0u << off);
+    for (;;) {
+        if (avail <= 32) {
+            return (avail < 32 ? m & first_lanes(avail) : m) == 0;
+        }
+        if (m) {
+            return false;
+        }
+        p += 32;
+        avail -= 32;
+        m = mask_avx2(_mm256_load_si256((const __m256i*)p));
+    }
+}
+
+SK_AVX2_FN static bool utf8_valid_avx2(const char *s, size_t n) {
+    const unsigned char *u = (const unsigned char*)s;
+    size_t i = 0;
+    while (i < n) {
+        if (n - i >= 32) {
+            if (mask_avx2(_mm256_loadu_si256((const __m256i*)(u + i))) == 0) {
+                i += 32;
+                continue;
+            }
+        } else if (is_ascii_avx2(s + i, n - i)) {
+            return true;            // Short ASCII tail: one masked aligned load
+        }
+        size_t block_end = i + 32 < n ? i + 32 : n;
+        while (i < block_end) {
+            size_t len = utf8_sequence(u + i, n - i);
+            if (len == 0) {
+                return false;
+            }
+            i += len;
+        }
+    }
+    return true;
+}
+
+static const sk_ops_t sk_ops_avx2 = {
+    strlen_avx2, streq_avx2, has_prefix_avx2,
+    memchr_avx2, is_ascii_avx2, utf8_valid_avx2,
+};
+
+#endif /* SK_X86 */
+
+/* =============================================================================
+ * SECTION 5: Runtime dispatch
+ * ============================================================================= */
+
+static _Atomic(const sk_ops_t *) sk_active;
+static _Atomic sk_level_t sk_active_level;
+
+static const sk_ops_t *ops_for(sk_level_t level) {
+    switch (level) {
+    case SK_SCALAR:
+        return &sk_ops_scalar;
+#if SK_X86
+    case SK_SSE2:
+        return __builtin_cpu_supports("sse2") ? &sk_ops_sse2 : NULL;
+    case SK_AVX2:
+        return __builtin_cpu_supports("avx2") ? &sk_ops_avx2 : NULL;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+int sk_select(sk_level_t level) {
+    const sk_ops_t *ops = ops_for(level);
+    if (ops == NULL) {
+        return -1;
+    }
+    atomic_store_explicit(&sk_active_level, level, memory_order_relaxed);
+    atomic_store_explicit(&sk_active, ops, memory_order_release);
+    return 0;
+}
+
+// Resolution is idempotent, so racing first calls just pick the same table
+static const sk_ops_t *sk_ops(void) {
+    const sk_ops_t *ops = atomic_load_explicit(&sk_active, memory_order_acquire);
+    if (__builtin_expect(ops != NULL, 1)) {
+        return ops;
+    }
+    for (int level = SK_LEVEL_COUNT - 1; level >= SK_SCALAR; level--) {
+        if (sk_select((sk_level_t)level) == 0) {
+            break;
+        }
+    }
+    return atomic_load_explicit(&sk_active, memory_order_acquire);
+}
+
+sk_level_t sk_level(void) {
+    sk_ops();
+    return atomic_load_explicit(&sk_active_level, memory_order_relaxed);
+}
+
+const char *sk_level_name(sk_level_t level) {
+    static const char *const names[SK_LEVEL_COUNT] = { "scalar", "sse2", "avx2" };
+    return (unsigned)level < SK_LEVEL_COUNT ? names[level] : "?";
+}
+
+size_t sk_strlen(const char *s) {
+    return sk_ops()->strlen(s);
+}
+
+bool sk_streq(const char *a, const char *b) {
+    return sk_ops()->streq(a, b);
+}
+
+bool sk_has_prefix(const char *s, const char *prefix) {
+    return sk_ops()->has_prefix(s, prefix);
+}
+
+const char *sk_memchr(const char *s, int c, size_t n) {
+    return sk_ops()->memchr(s, c, n);
+}
+
+bool sk_is_ascii(const char *s, size_t n) {
+    return sk_ops()->is_ascii(s, n);
+}
+
+bool sk_utf8_valid(const char *s, size_t n) {
+    return sk_ops()->utf8_valid(s, n);
+}
@@ -0,0 +1,79 @@
+#ifndef STRKERN_H
+#define STRKERN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* =============================================================================
+ * SIMD String Kernels
+ * =============================================================================
+ * libc-style string primitives for parsing text telemetry, with SSE2 and
+ * AVX2 versions selected at run time and a portable scalar fallback.
+ *
+ *     size_t n = sk_strlen(line);
+ *     if (sk_has_prefix(line, "$GPGGA,")) { ... }
+ *     const char *comma = sk_memchr(field, ',', n);
+ *
+ * Reading past the terminator is page safe: NUL-terminated kernels only use
+ * aligned vector loads (an aligned block never straddles a page), or check
+ * for a page crossing before an unaligned load and fall back to bytes there.
+ * Aligned loads may read bytes before the string start or after its end, but
+ * never outside the pages that hold the string. AddressSanitizer flags this
+ * deliberate over-read, so sanitizer builds should use sk_select(SK_SCALAR).
+ *
+ * The first call picks the widest level the CPU supports; sk_select() forces
+ * one (used by the fuzz tests and benchmark to compare levels).
+ */
+
+typedef enum {
+    SK_SCALAR = 0,
+    SK_SSE2,
+    SK_AVX2,
+    SK_LEVEL_COUNT
+} sk_level_t;
+
+/**
+ * @brief strlen()
+ */
+size_t sk_strlen(const char *s);
+
+/**
+ * @brief strcmp(a, b) == 0
+ */
+bool sk_streq(const char *a, const char *b);
+
+/**
+ * @brief strncmp(s, prefix, strlen(prefix)) == 0
+ */
+bool sk_has_prefix(const char *s, const char *prefix);
+
+/**
+ * @brief memchr(): first occurrence of byte c in s[0..n), or NULL
+ */
+const char *sk_memchr(const char *s, int c, size_t n);
+
+/**
+ * @brief True if every byte of s[0..n) is 7-bit ASCII
+ */
+bool sk_is_ascii(const char *s, size_t n);
+
+/**
+ * @brief True if s[0..n) is well-formed UTF-8 (RFC 3629: no overlong forms,
+ * no surrogates, nothing above U+10FFFF)
+ */
+bool sk_utf8_valid(const char *s, size_t n);
+
+/**
+ * @brief Force an implementation level
+ * @return 0 on success, -1 if the CPU (or build target) does not support it
+ */
+int sk_select(sk_level_t level);
+
+/**
+ * @brief Level in use (resolving it on first call)
+ */
+sk_level_t sk_level(void);
+
+const char *sk_level_name(sk_level_t level);
+
+#endif /* STRKERN_H */
@@ -0,0 +1,318 @@
+#define _DEFAULT_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "strkern.h"
+
+/* =============================================================================
+ * SECTION 1: Guarded buffers
+ * =============================================================================
+ * Every fuzz string is placed so that it ends right before a PROT_NONE page.
+ * A kernel that reads one byte too far across the page boundary crashes here
+ * instead of passing silently.
+ */
+
+typedef struct {
+    char *page;         // Readable page; the page after it is PROT_NONE
+    size_t size;
+} guarded_t;
+
+static guarded_t guarded_alloc(void) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    char *mem = mmap(NULL, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED || mprotect(mem + page, page, PROT_NONE) != 0) {
+        perror("mmap");
+        exit(1);
+    }
+    guarded_t g = { mem, page };
+    return g;
+}
+
+// Copy len bytes (plus a NUL if terminate) so they end `slack` bytes before the guard page
+static char *guarded_place(guarded_t *g, const char *src, size_t len, int terminate, size_t slack) {
+    char *dst = g->page + g->size - len - (terminate ? 1 : 0) - slack;
+    memcpy(dst, src, len);
+    if (terminate) {
+        dst[len] = '\0';
+    }
+    return dst;
+}
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint32_t rnd(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32);
+}
+
+// Printable text with the occasional byte >= 0x80 (never NUL)
+static void random_text(char *buf, size_t len, int high_bytes) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (char)(' ' + rnd() % 95);
+        if (high_bytes && rnd() % 64 == 0) {
+            buf[i] = (char)(0x80 | (rnd() & 0x7F));
+        }
+    }
+}
+
+// Mostly ASCII with valid 2-, 3- and 4-byte sequences, optionally corrupted
+static size_t random_utf8(unsigned char *buf, size_t cap) {
+    size_t n = 0;
+    while (n + 4 <= cap) {
+        uint32_t kind = rnd() % 16, cp;
+        if (kind < 10) {
+            buf[n++] = (unsigned char)(' ' + rnd() % 95);
+            continue;
+        } else if (kind < 12) {
+            cp = 0x80 + rnd() % (0x800 - 0x80);
+            buf[n++] = (unsigned char)(0xC0 | (cp >> 6));
+        } else if (kind < 14) {
+            do {
+                cp = 0x800 + rnd() % (0x10000 - 0x800);
+            } while (cp >= 0xD800 && cp <= 0xDFFF);
+            buf[n++] = (unsigned char)(0xE0 | (cp >> 12));
+            buf[n++] = (unsigned char)(0x80 | ((cp >> 6) & 0x3F));
+        } else {
+            cp = 0x10000 + rnd() % (0x110000 - 0x10000);
+            buf[n++] = (unsigned char)(0xF0 | (cp >> 18));
+            buf[n++] = (unsigned char)(0x80 | ((cp >> 12) & 0x3F));
+            buf[n++] = (unsigned char)(0x80 | ((cp >> 6) & 0x3F));
+        }
+        buf[n++] = (unsigned char)(0x80 | (cp & 0x3F));
+    }
+    if (n > 0 && rnd() % 3 == 0) {
+        buf[rnd() % n] = (unsigned char)rnd();     // May or may not break it
+    }
+    return n;
+}
+
+/* =============================================================================
+ * SECTION 2: Fuzz tests - every level against the scalar reference
+ * ============================================================================= */
+
+#define FUZZ_ITERATIONS 200000
+#define FUZZ_MAX_LEN    300
+
+static int failures;
+
+#define CHECK(cond, ...)                                            \
+    do {                                                            \
+        if (!(cond)) {                                              \
+            if (failures++ < 10) {                                  \
+                printf("  FAIL [%s] ", sk_level_name(sk_level()));   \
+                printf(__VA_ARGS__);                                \
+                printf("\n");                                       \
+            }                                                       \
+        }                                                           \
+    } while (0)
+
+static int utf8_reference(const unsigned char *s, size_t n) {
+    sk_level_t level = sk_level();
+    sk_select(SK_SCALAR);
+    int ok = sk_utf8_valid((const char*)s, n);
+    sk_select(level);
+    return ok;
+}
+
+static void fuzz_level(sk_level_t level, guarded_t *ga, guarded_t *gb) {
+    char text[FUZZ_MAX_LEN + 1];
+    char other[FUZZ_MAX_LEN + 1];
+    sk_select(level);
+
+    for (int it = 0; it < FUZZ_ITERATIONS; it++) {
+        size_t len = rnd() % FUZZ_MAX_LEN;
+        size_t slack_a = rnd() % 3 == 0 ? 0 : rnd() % 64;
+        size_t slack_b = rnd() % 3 == 0 ? 0 : rnd() % 64;
+        random_text(text, len, 1);
+        const char *a = guarded_place(ga, text, len, 1, slack_a);
+
+        CHECK(sk_strlen(a) == len, "strlen len=%zu", len);
+
+        // streq: identical, one byte changed, or truncated
+        memcpy(other, text, len);
+        size_t other_len = len;
+        int mode = rnd() % 3;
+        if (mode == 1 && len > 0) {
+            size_t at = rnd() % len;
+            char changed;
+            do {
+                changed = (char)(' ' + rnd() % 95);     // Never NUL, never the same
+            } while (changed == other[at]);
+            other[at] = changed;
+        } else if (mode == 2 && len > 0) {
+            other_len = rnd() % len;
+        }
+        const char *b = guarded_place(gb, other, other_len, 1, slack_b);
+        int expect_eq = other_len == len && memcmp(text, other, len) == 0;
+        CHECK(sk_streq(a, b) == expect_eq, "streq len=%zu mode=%d", len, mode);
+        CHECK(sk_streq(b, a) == expect_eq, "streq (swapped) len=%zu mode=%d", len, mode);
+
+        // has_prefix: b is a prefix of a unless it was changed
+        int expect_prefix = other_len <= len && memcmp(text, other, other_len) == 0;
+        CHECK(sk_has_prefix(a, b) == expect_prefix, "has_prefix len=%zu plen=%zu", len, other_len);
+
+        // memchr: a byte that is present, or one that is not
+        int c = rnd() % 2 && len > 0 ? (unsigned char)text[rnd() % len] : (int)(rnd() % 256);
+        const char *u = guarded_place(ga, text, len, 0, slack_a);
+        CHECK(sk_memchr(u, c, len) == memchr(u, c, len), "memchr len=%zu c=%d", len, c);
+        if (memchr(u, c, len) != NULL) {
+            // An unbounded length is fine once c is known to occur before the guard page
+            CHECK(sk_memchr(u, c, (size_t)-1) == memchr(u, c, len), "memchr n=SIZE_MAX len=%zu c=%d", len, c);
+        }
+
+        // is_ascii on unterminated input right up against the guard page
+        int ascii = 1;
+        for (size_t i = 0; i < len; i++) {
+            ascii &= (unsigned char)text[i] < 0x80;
+        }
+        CHECK(sk_is_ascii(u, len) == ascii, "is_ascii len=%zu", len);
+
+        unsigned char utf[FUZZ_MAX_LEN];
+        size_t ulen = random_utf8(utf, len);
+        const char *v = guarded_place(gb, (const char*)utf, ulen, 0, slack_b);
+        CHECK(sk_utf8_valid(v, ulen) == utf8_reference(utf, ulen), "utf8_valid len=%zu", ulen);
+    }
+}
+
+static void utf8_known_vectors(void) {
+    static const struct { const char *bytes; size_t len; int valid; } vectors[] = {
+        { "plain ascii", 11, 1 },
+        { "\xC3\xA9t\xC3\xA9", 5, 1 },                  // "ete" with accents
+        { "\xE2\x82\xAC", 3, 1 },                       // Euro sign
+        { "\xF0\x9F\x98\x80", 4, 1 },                   // U+1F600
+        { "\xF4\x8F\xBF\xBF", 4, 1 },                   // U+10FFFF, the last code point
+        { "\xC0\x80", 2, 0 },                           // Overlong NUL
+        { "\xE0\x9F\xBF", 3, 0 },                       // Overlong 3-byte
+        { "\xED\xA0\x80", 3, 0 },                       // Surrogate U+D800
+        { "\xF4\x90\x80\x80", 4, 0 },                   // U+110000
+        { "\xE2\x82", 2, 0 },                           // Truncated
+        { "\x80", 1, 0 },                               // Stray continuation
+        { "\xFF", 1, 0 },
+    };
+    for (int level = 0; level < SK_LEVEL_COUNT; level++) {
+        if (sk_select((sk_level_t)level) != 0) {
+            continue;
+        }
+        for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+            CHECK(sk_utf8_valid(vectors[i].bytes, vectors[i].len) == vectors[i].valid,
+                  "utf8 vector %zu", i);
+        }
+    }
+}
+
+/* =============================================================================
+ * SECTION 3: Throughput across string lengths
+ * ============================================================================= */
+
+#define BENCH_BYTES (64u << 20)     // Bytes processed per measurement
+
+static double seconds_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+typedef enum { OP_STRLEN, OP_STREQ, OP_PREFIX, OP_MEMCHR, OP_ASCII, OP_UTF8, OP_COUNT } op_t;
+
+static const char *const op_names[OP_COUNT] = {
+    "strlen", "streq", "has_prefix", "memchr", "is_ascii", "utf8_valid",
+};
+
+// Level index SK_LEVEL_COUNT means "libc"
+static size_t run_op(op_t op, int level, const char *a, const char *b, size_t len) {
+    int libc = level == SK_LEVEL_COUNT;
+    switch (op) {
+    case OP_STRLEN:
+        return libc ? strlen(a) : sk_strlen(a);
+    case OP_STREQ:
+        return libc ? strcmp(a, b) == 0 : sk_streq(a, b);
+    case OP_PREFIX:
+        return libc ? strncmp(a, b, len) == 0 : sk_has_prefix(a, b);
+    case OP_MEMCHR:
+        return (size_t)(libc ? memchr(a, '\n', len) : sk_memchr(a, '\n', len));
+    case OP_ASCII:
+        return libc ? 0 : sk_is_ascii(a, len);
+    case OP_UTF8:
+        return libc ? 0 : sk_utf8_valid(a, len);
+    default:
+        return 0;
+    }
+}
+
+static void throughput(void) {
+    static const size_t lengths[] = { 8, 16, 32, 64, 256, 4096 };
+    enum { NLEN = sizeof(lengths) / sizeof(lengths[0]) };
+    char *a = aligned_alloc(64, 8192);
+    char *b = aligned_alloc(64, 8192);
+
+    printf("\nThroughput in GB/s (text telemetry lines; memchr looks for a missing '\\n'):\n");
+    printf("%-12s %-7s", "op", "impl");
+    for (int l = 0; l < NLEN; l++) {
+        printf(" %7zuB", lengths[l]);
+    }
+    printf("\n");
+
+    for (int op = 0; op < OP_COUNT; op++) {
+        for (int level = 0; level <= SK_LEVEL_COUNT; level++) {
+            int libc = level == SK_LEVEL_COUNT;
+            if (libc && (op == OP_ASCII || op == OP_UTF8)) {
+                continue;       // No libc equivalent
+            }
+            if (!libc && sk_select((sk_level_t)level) != 0) {
+                continue;
+            }
+            printf("%-12s %-7s", op_names[op], libc ? "libc" : sk_level_name((sk_level_t)level));
+            for (int l = 0; l < NLEN; l++) {
+                size_t len = lengths[l];
+                // Misaligned by 3 so the kernels cannot rely on aligned input
+                char *sa = a + 3, *sb = b + 5;
+                random_text(sa, len, 0);
+                sa[len] = '\0';
+                memcpy(sb, sa, len + 1);
+                size_t reps = BENCH_BYTES / len;
+                size_t sink = 0;
+
+                double t0 = seconds_now();
+                for (size_t r = 0; r < reps; r++) {
+                    __asm__ volatile("" : : "r"(sa), "r"(sb) : "memory");
+                    sink += run_op((op_t)op, level, sa, sb, len);
+                }
+                double t1 = seconds_now();
+                __asm__ volatile("" : : "r"(sink));
+                printf(" %8.2f", (double)(reps * len) / (t1 - t0) / 1e9);
+            }
+            printf("\n");
+        }
+    }
+    free(a);
+    free(b);
+}
+
+int main(void) {
+    guarded_t ga = guarded_alloc();
+    guarded_t gb = guarded_alloc();
+
+    printf("SIMD string kernels - default level: %s\n\n", sk_level_name(sk_level()));
+    printf("Fuzzing %d strings per level, each ending at a PROT_NONE page:\n", FUZZ_ITERATIONS);
+    for (int level = 0; level < SK_LEVEL_COUNT; level++) {
+        if (sk_select((sk_level_t)level) != 0) {
+            printf("  %-7s not supported on this CPU\n", sk_level_name((sk_level_t)level));
+            continue;
+        }
+        int before = failures;
+        fuzz_level((sk_level_t)level, &ga, &gb);
+        printf("  %-7s %s\n", sk_level_name((sk_level_t)level), failures == before ? "ok" : "FAILED");
+    }
+    utf8_known_vectors();
+    printf("  utf8 known vectors %s\n", failures ? "checked (see failures above)" : "ok");
+
+    throughput();
+    return failures != 0;
+}
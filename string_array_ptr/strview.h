@@ -0,0 +1,149 @@
+#ifndef STRVIEW_H
+#define STRVIEW_H
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* =============================================================================
+ * Non-Owning String View
+ * =============================================================================
+ * A third representation next to `char *str1` and `char str2[]`: a pointer
+ * plus a length into someone else's storage.
+ *
+ *     strview_t line = sv_make(rx_buf, rx_len);   // No NUL needed
+ *     strview_t field;
+ *     while (sv_split_next(&line, ',', &field)) {
+ *         printf(SV_FMT "\n", SV_ARG(field));      // Slices, never copies
+ *     }
+ *
+ * The length travels with the pointer, so nothing ever calls strlen() again
+ * and slicing is two integer operations. A view does not own its bytes: it
+ * is only valid while the buffer it points into is.
+ */
+
+typedef struct {
+    const char *ptr;
+    size_t len;
+} strview_t;
+
+#define SV_NPOS     ((size_t)-1)
+
+// View of a string literal, length computed at compile time
+#define SV_LIT(lit) ((strview_t){ (lit), sizeof(lit) - 1 })
+
+// printf("%.*s") support: printf(SV_FMT, SV_ARG(v))
+#define SV_FMT      "%.*s"
+#define SV_ARG(v)   (int)(v).len, (v).ptr
+
+static inline strview_t sv_make(const char *ptr, size_t len) {
+    strview_t v = { ptr, len };
+    return v;
+}
+
+static inline strview_t sv_from_cstr(const char *s) {
+    return sv_make(s, strlen(s));
+}
+
+/**
+ * @brief Bytes [start, end) of v; both bounds are clamped to the view
+ */
+static inline strview_t sv_slice(strview_t v, size_t start, size_t end) {
+    end = end < v.len ? end : v.len;
+    start = start < end ? start : end;
+    return sv_make(v.ptr + start, end - start);
+}
+
+static inline bool sv_eq(strview_t a, strview_t b) {
+    return a.len == b.len && (a.len == 0 || memcmp(a.ptr, b.ptr, a.len) == 0);
+}
+
+static inline bool sv_starts_with(strview_t v, strview_t prefix) {
+    return v.len >= prefix.len && (prefix.len == 0 || memcmp(v.ptr, prefix.ptr, prefix.len) == 0);
+}
+
+/**
+ * @brief Index of the first c in v, or SV_NPOS
+ */
+static inline size_t sv_find(strview_t v, char c) {
+    const char *hit = v.len ? memchr(v.ptr, c, v.len) : NULL;
+    return hit ? (size_t)(hit - v.ptr) : SV_NPOS;
+}
+
+static inline strview_t sv_trim(strview_t v) {
+    while (v.len > 0 && (v.ptr[0] == ' ' || v.ptr[0] == '\t')) {
+        v.ptr++;
+        v.len--;
+    }
+    while (v.len > 0 && (v.ptr[v.len - 1] == ' ' || v.ptr[v.len - 1] == '\t' ||
+                         v.ptr[v.len - 1] == '\r' || v.ptr[v.len - 1] == '\n')) {
+        v.len--;
+    }
+    return v;
+}
+
+/**
+ * @brief Zero-copy tokenizer: pop the text up to the next delim from *rest
+ * Unlike strtok() it does not write into the input and keeps no hidden state.
+ * Empty fields are returned as empty views.
+ * @return false once *rest has been consumed
+ */
+static inline bool sv_split_next(strview_t *rest, char delim, strview_t *token) {
+    if (rest->ptr == NULL) {
+        return false;
+    }
+    size_t at = sv_find(*rest, delim);
+    if (at == SV_NPOS) {
+        *token = *rest;
+        rest->ptr = NULL;       // The last field has been handed out
+        rest->len = 0;
+        return true;
+    }
+    *token = sv_make(rest->ptr, at);
+    *rest = sv_make(rest->ptr + at + 1, rest->len - at - 1);
+    return true;
+}
+
+/**
+ * @brief Split v at the first c into *left and *right (c itself is dropped)
+ * @return false if c does not occur; *left is then v and *right empty
+ */
+static inline bool sv_cut(strview_t v, char c, strview_t *left, strview_t *right) {
+    size_t at = sv_find(v, c);
+    if (at == SV_NPOS) {
+        *left = v;
+        *right = sv_make(v.ptr + v.len, 0);
+        return false;
+    }
+    *left = sv_make(v.ptr, at);
+    *right = sv_make(v.ptr + at + 1, v.len - at - 1);
+    return true;
+}
+
+/**
+ * @brief Parse a decimal integer that fills the whole view (no NUL required)
+ * @return false on empty input, stray characters or overflow
+ */
+static inline bool sv_to_long(strview_t v, long *out) {
+    size_t i = 0;
+    bool negative = v.len > 0 && v.ptr[0] == '-';
+    unsigned long value = 0;
+    unsigned long limit = (unsigned long)LONG_MAX + negative;     // |LONG_MIN| = LONG_MAX + 1
+
+    i += negative;
+    if (i == v.len) {
+        return false;
+    }
+    for (; i < v.len; i++) {
+        unsigned digit = (unsigned)(v.ptr[i] - '0');
+        if (digit > 9 || value > (limit - digit) / 10) {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+    *out = negative ? (long)(0 - value) : (long)value;
+    return true;
+}
+
+#endif /* STRVIEW_H */
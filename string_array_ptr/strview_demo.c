@@ -0,0 +1,263 @@
+#define _DEFAULT_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "smallstr.h"
+#include "strview.h"
+
+/* =============================================================================
+ * SECTION 1: Workload - key=value telemetry lines
+ * ============================================================================= */
+
+#define LINES 200000
+
+static char *lines[LINES];
+static size_t line_lens[LINES];
+
+static const char *const devices[] = { "pump-07", "valve-inlet-3", "boiler-main", "fan-2" };
+static const char *const statuses[] = { "ok", "ok", "ok", "warn", "alarm" };
+static const char *const messages[] = {
+    "", "", "", "door open", "pressure above threshold on inlet valve 3",
+};
+
+static void make_lines(void) {
+    char buf[256];
+    uint32_t x = 12345;
+    for (int i = 0; i < LINES; i++) {
+        x = x * 1103515245u + 12345u;
+        uint32_t r = x >> 8;
+        int n = snprintf(buf, sizeof(buf), "dev=%s,ts=%ld,temp=%d,unit=degC,status=%s,msg=%s",
+                         devices[r % 4], 1700000000L + i, (int)(r % 9000) - 1000,
+                         statuses[(r >> 4) % 5], messages[(r >> 8) % 5]);
+        lines[i] = strdup(buf);
+        line_lens[i] = (size_t)n;
+    }
+}
+
+static uint32_t fnv1a(uint32_t h, const char *s, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        h = (h ^ (uint8_t)s[i]) * 16777619u;
+    }
+    return h;
+}
+
+static double seconds_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* =============================================================================
+ * SECTION 2: Before - NUL-terminated strings, strtok and heap copies
+ * ============================================================================= */
+
+static size_t heap_allocs;
+
+static void *counted_malloc(size_t n) {
+    heap_allocs++;
+    return malloc(n);
+}
+
+static char *counted_strdup(const char *s) {
+    size_t n = strlen(s) + 1;
+    char *copy = counted_malloc(n);
+    memcpy(copy, s, n);
+    return copy;
+}
+
+typedef struct {
+    char *device;
+    long ts;
+    long temp;
+    char *unit;
+    char *status;
+    char *message;
+} record_cstr_t;
+
+static void parse_cstr(const char *line, record_cstr_t *rec) {
+    char *work = counted_strdup(line);      // strtok writes into its input
+    char *save = NULL;
+    memset(rec, 0, sizeof(*rec));
+
+    for (char *tok = strtok_r(work, ",", &save); tok != NULL; tok = strtok_r(NULL, ",", &save)) {
+        char *eq = strchr(tok, '=');
+        if (eq == NULL) {
+            continue;
+        }
+        *eq = '\0';
+        const char *key = tok, *value = eq + 1;
+        if (strcmp(key, "dev") == 0) {
+            rec->device = counted_strdup(value);
+        } else if (strcmp(key, "ts") == 0) {
+            rec->ts = atol(value);
+        } else if (strcmp(key, "temp") == 0) {
+            rec->temp = atol(value);
+        } else if (strcmp(key, "unit") == 0) {
+            rec->unit = counted_strdup(value);
+        } else if (strcmp(key, "status") == 0) {
+            rec->status = counted_strdup(value);
+        } else if (strcmp(key, "msg") == 0) {
+            rec->message = counted_strdup(value);
+        }
+    }
+    free(work);
+}
+
+static char *format_cstr(const record_cstr_t *rec) {
+    const char *fmt = "%s @%ld temp=%ld %s [%s]%s%s";
+    const char *sep = rec->message[0] ? " " : "";
+    int n = snprintf(NULL, 0, fmt, rec->device, rec->ts, rec->temp, rec->unit, rec->status,
+                     sep, rec->message);
+    char *out = counted_malloc((size_t)n + 1);
+    snprintf(out, (size_t)n + 1, fmt, rec->device, rec->ts, rec->temp, rec->unit, rec->status,
+             sep, rec->message);
+    return out;
+}
+
+static void free_cstr(record_cstr_t *rec) {
+    free(rec->device);
+    free(rec->unit);
+    free(rec->status);
+    free(rec->message);
+}
+
+/* =============================================================================
+ * SECTION 3: After - views into the line, small strings, one arena per line
+ * ============================================================================= */
+
+typedef struct {
+    smallstr_t device;
+    long ts;
+    long temp;
+    smallstr_t unit;
+    smallstr_t status;
+    smallstr_t message;
+} record_t;
+
+static void parse_view(strview_t line, record_t *rec, str_arena_t *arena) {
+    strview_t field, key, value;
+    ss_init(&rec->device);
+    ss_init(&rec->unit);
+    ss_init(&rec->status);
+    ss_init(&rec->message);
+    rec->ts = rec->temp = 0;
+
+    while (sv_split_next(&line, ',', &field)) {
+        if (!sv_cut(field, '=', &key, &value)) {
+            continue;
+        }
+        if (sv_eq(key, SV_LIT("dev"))) {
+            ss_assign(&rec->device, value, arena);
+        } else if (sv_eq(key, SV_LIT("ts"))) {
+            sv_to_long(value, &rec->ts);
+        } else if (sv_eq(key, SV_LIT("temp"))) {
+            sv_to_long(value, &rec->temp);
+        } else if (sv_eq(key, SV_LIT("unit"))) {
+            ss_assign(&rec->unit, value, arena);
+        } else if (sv_eq(key, SV_LIT("status"))) {
+            ss_assign(&rec->status, value, arena);
+        } else if (sv_eq(key, SV_LIT("msg"))) {
+            ss_assign(&rec->message, value, arena);
+        }
+    }
+}
+
+static void format_view(const record_t *rec, smallstr_t *out, str_arena_t *arena) {
+    ss_init(out);
+    ss_append(out, ss_view(&rec->device), arena);
+    ss_append(out, SV_LIT(" @"), arena);
+    ss_append_long(out, rec->ts, arena);
+    ss_append(out, SV_LIT(" temp="), arena);
+    ss_append_long(out, rec->temp, arena);
+    ss_append_char(out, ' ', arena);
+    ss_append(out, ss_view(&rec->unit), arena);
+    ss_append(out, SV_LIT(" ["), arena);
+    ss_append(out, ss_view(&rec->status), arena);
+    ss_append_char(out, ']', arena);
+    if (ss_len(&rec->message) > 0) {
+        ss_append_char(out, ' ', arena);
+        ss_append(out, ss_view(&rec->message), arena);
+    }
+}
+
+/* =============================================================================
+ * SECTION 4: Measurement
+ * ============================================================================= */
+
+static void representations(void) {
+    char *str1 = "string";                      // Pointer into .rodata
+    char str2[] = "string";                     // Array copy on the stack
+    strview_t str3 = sv_slice(SV_LIT("a string literal"), 2, 8);   // Pointer + length
+    str_arena_t arena;
+    smallstr_t str4, str5;
+
+    str_arena_init(&arena, 256);
+    ss_init(&str4);
+    ss_init(&str5);
+    ss_assign(&str4, SV_LIT("short"), &arena);
+    ss_assign(&str5, SV_LIT("this one is longer than 22 bytes"), &arena);
+
+    printf("str1 (char *)      %-34s %p\n", str1, (void*)str1);
+    printf("str2 (char[])      %-34s %p\n", str2, (void*)str2);
+    printf("str3 (strview_t)   " SV_FMT "%*s %p (len %zu, no NUL)\n",
+           SV_ARG(str3), 34 - (int)str3.len, "", (void*)str3.ptr, str3.len);
+    printf("str4 (smallstr_t)  %-34s %p (inline, sizeof %zu)\n",
+           ss_cstr(&str4), (void*)ss_cstr(&str4), sizeof(str4));
+    printf("str5 (smallstr_t)  %-34s %p (spilled to arena)\n\n",
+           ss_cstr(&str5), (void*)ss_cstr(&str5));
+    str_arena_free(&arena);
+}
+
+int main(void) {
+    representations();
+    make_lines();
+
+    // Before
+    uint32_t hash_before = 2166136261u;
+    heap_allocs = 0;
+    double t0 = seconds_now();
+    for (int i = 0; i < LINES; i++) {
+        record_cstr_t rec;
+        parse_cstr(lines[i], &rec);
+        char *out = format_cstr(&rec);
+        hash_before = fnv1a(hash_before, out, strlen(out));
+        free(out);
+        free_cstr(&rec);
+    }
+    double t1 = seconds_now();
+    size_t allocs_before = heap_allocs;
+
+    // After: the arena is reset per line, so its first chunk is reused forever
+    str_arena_t arena;
+    str_arena_init(&arena, 1024);
+    uint32_t hash_after = 2166136261u;
+    size_t spilled = 0;
+    double t2 = seconds_now();
+    for (int i = 0; i < LINES; i++) {
+        record_t rec;
+        smallstr_t out;
+        parse_view(sv_make(lines[i], line_lens[i]), &rec, &arena);
+        format_view(&rec, &out, &arena);
+        hash_after = fnv1a(hash_after, ss_cstr(&out), ss_len(&out));
+        spilled += !ss_is_inline(&rec.message) + !ss_is_inline(&out);
+        str_arena_reset(&arena);
+    }
+    double t3 = seconds_now();
+    size_t allocs_after = arena.chunk_allocs;
+    str_arena_free(&arena);
+
+    printf("Parse + format %d telemetry lines (%s output):\n", LINES,
+           hash_before == hash_after ? "identical" : "DIFFERENT");
+    printf("  strtok/strdup/snprintf  %7.1f ns/line  %9zu mallocs (%.1f per line)\n",
+           (t1 - t0) * 1e9 / LINES, allocs_before, (double)allocs_before / LINES);
+    printf("  strview/smallstr        %7.1f ns/line  %9zu mallocs (%zu spills into the arena)\n",
+           (t3 - t2) * 1e9 / LINES, allocs_after, spilled);
+
+    for (int i = 0; i < LINES; i++) {
+        free(lines[i]);
+    }
+    return hash_before != hash_after;
+}
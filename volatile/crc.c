@@ -0,0 +1,346 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#include "crc.h"
+
+#if defined(__x86_64__)
+#define CRC_X86_64 1
+#include <immintrin.h>
+#else
+#define CRC_X86_64 0
+#endif
+
+typedef struct crc_params crc_params_t;
+typedef uint32_t (*crc_fn)(const crc_params_t *p, uint32_t crc, const uint8_t *data, size_t len);
+
+struct crc_params {
+    const char *name;
+    uint8_t width;
+    uint8_t reflected;          // Bits enter LSB-first (UART bit order)
+    uint32_t poly;              // Normal form, without the x^width term
+    uint32_t init;
+    uint32_t xorout;
+    uint32_t check;             // CRC of "123456789"
+    uint32_t table[8][256];     // table[k][b]: byte b followed by k zero bytes
+    uint64_t fold1[2];          // PCLMUL constants for folding by 128 bits
+    uint64_t fold4[2];          // ... and by 512 bits (four accumulators)
+    crc_fn short_fn;            // PCLMUL path: short inputs and the final bytes
+};
+
+static crc_params_t crc_params[CRC_ALGO_COUNT] = {
+    { "CRC-16/CCITT-FALSE", 16, 0, 0x1021,     0xFFFF,     0x0000,     0x29B1,     {{0}}, {0}, {0}, NULL },
+    { "CRC-32",             32, 1, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, 0xCBF43926, {{0}}, {0}, {0}, NULL },
+    { "CRC-32C",            32, 1, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, 0xE3069283, {{0}}, {0}, {0}, NULL },
+};
+
+/* =============================================================================
+ * SECTION 1: Table generation
+ * ============================================================================= */
+
+static uint32_t reflect32(uint32_t x) {
+    uint32_t r = 0;
+    for (int i = 0; i < 32; i++) {
+        r |= ((x >> i) & 1u) << (31 - i);
+    }
+    return r;
+}
+
+// x^n mod P for a 32-bit CRC polynomial, as a normal-form remainder
+static uint32_t xpow_mod(unsigned n, uint32_t poly) {
+    uint64_t r = 1;
+    while (n--) {
+        r <<= 1;
+        if (r & (1ull << 32)) {
+            r ^= (1ull << 32) | poly;
+        }
+    }
+    return (uint32_t)r;
+}
+
+// Remainder reflected over 64 bits: the operand layout PCLMUL folding needs
+static uint64_t fold_constant(unsigned n, uint32_t poly) {
+    return (uint64_t)reflect32(xpow_mod(n, poly)) << 32;
+}
+
+static uint32_t crc_slice8(const crc_params_t *p, uint32_t crc, const uint8_t *d, size_t n);
+#if CRC_X86_64
+static uint32_t crc_sse42(const crc_params_t *p, uint32_t crc, const uint8_t *d, size_t n);
+#endif
+
+static void build_tables(void) {
+    for (int a = 0; a < CRC_ALGO_COUNT; a++) {
+        crc_params_t *p = &crc_params[a];
+
+        p->short_fn = crc_slice8;
+#if CRC_X86_64
+        if (a == CRC32C && __builtin_cpu_supports("sse4.2")) {
+            p->short_fn = crc_sse42;
+        }
+#endif
+
+        if (p->reflected) {
+            uint32_t rpoly = reflect32(p->poly);
+            for (uint32_t b = 0; b < 256; b++) {
+                uint32_t c = b;
+                for (int k = 0; k < 8; k++) {
+                    c = (c & 1) ? (c >> 1) ^ rpoly : c >> 1;
+                }
+                p->table[0][b] = c;
+            }
+            for (int t = 1; t < 8; t++) {
+                for (uint32_t b = 0; b < 256; b++) {
+                    uint32_t prev = p->table[t - 1][b];
+                    p->table[t][b] = (prev >> 8) ^ p->table[0][prev & 0xFF];
+                }
+            }
+            // Fold distance d uses x^(d+64-1) for the high half and x^(d-1)
+            // for the low half; the -1 absorbs PCLMUL's 127-bit product
+            p->fold1[0] = fold_constant(128 + 64 - 1, p->poly);
+            p->fold1[1] = fold_constant(128 - 1, p->poly);
+            p->fold4[0] = fold_constant(512 + 64 - 1, p->poly);
+            p->fold4[1] = fold_constant(512 - 1, p->poly);
+        } else {
+            uint32_t top = 1u << (p->width - 1);
+            uint32_t mask = (top << 1) - 1;
+            for (uint32_t b = 0; b < 256; b++) {
+                uint32_t c = b << (p->width - 8);
+                for (int k = 0; k < 8; k++) {
+                    c = (c & top) ? ((c << 1) ^ p->poly) & mask : (c << 1) & mask;
+                }
+                p->table[0][b] = c;
+            }
+            for (int t = 1; t < 8; t++) {
+                for (uint32_t b = 0; b < 256; b++) {
+                    uint32_t prev = p->table[t - 1][b];
+                    p->table[t][b] = ((prev << 8) & mask) ^ p->table[0][prev >> (p->width - 8)];
+                }
+            }
+        }
+    }
+}
+
+/* =============================================================================
+ * SECTION 2: Table-driven implementations
+ * ============================================================================= */
+
+static uint32_t load_le32(const uint8_t *b) {
+    return (uint32_t)b[0] | (uint32_t)b[1] << 8 | (uint32_t)b[2] << 16 | (uint32_t)b[3] << 24;
+}
+
+static uint32_t crc_bytewise(const crc_params_t *p, uint32_t crc, const uint8_t *d, size_t n) {
+    const uint32_t *t = p->table[0];
+    if (p->reflected) {
+        while (n--) {
+            crc = (crc >> 8) ^ t[(crc ^ *d++) & 0xFF];
+        }
+    } else {
+        // Only CRC-16 is MSB-first here
+        while (n--) {
+            crc = ((crc << 8) & 0xFFFF) ^ t[((crc >> 8) ^ *d++) & 0xFF];
+        }
+    }
+    return crc;
+}
+
+static uint32_t crc_slice8(const crc_params_t *p, uint32_t crc, const uint8_t *d, size_t n) {
+    const uint32_t (*t)[256] = p->table;
+    if (p->reflected) {
+        while (n >= 8) {
+            uint32_t lo = crc ^ load_le32(d);
+            uint32_t hi = load_le32(d + 4);
+            crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                  t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+            d += 8;
+            n -= 8;
+        }
+    } else {
+        while (n >= 8) {
+            uint32_t c = crc ^ ((uint32_t)d[0] << 8 | d[1]);
+            crc = t[7][c >> 8] ^ t[6][c & 0xFF] ^ t[5][d[2]] ^ t[4][d[3]] ^
+                  t[3][d[4]] ^ t[2][d[5]] ^ t[1][d[6]] ^ t[0][d[7]];
+            d += 8;
+            n -= 8;
+        }
+    }
+    return crc_bytewise(p, crc, d, n);
+}
+
+#if CRC_X86_64
+
+/* =============================================================================
+ * SECTION 3: SSE4.2 crc32 instruction (CRC-32C only)
+ * ============================================================================= */
+
+__attribute__((target("sse4.2")))
+static uint32_t crc_sse42(const crc_params_t *p, uint32_t crc, const uint8_t *d, size_t n) {
+    (void)p;
+    uint64_t c = crc;
+    while (n >= 8) {
+        uint64_t w;
+        memcpy(&w, d, 8);
+        c = _mm_crc32_u64(c, w);
+        d += 8;
+        n -= 8;
+    }
+    while (n--) {
+        c = _mm_crc32_u8((uint32_t)c, *d++);
+    }
+    return (uint32_t)c;
+}
+
+/* =============================================================================
+ * SECTION 4: PCLMULQDQ folding (reflected 32-bit CRCs)
+ * =============================================================================
+ * Four 128-bit accumulators each absorb one 16-byte block per step:
+ * acc = lo64(acc) * K_hi  ^  hi64(acc) * K_lo  ^  next block, which moves
+ * acc 512 bits forward without changing its value mod P. The accumulators
+ * are then folded into one, and its 16 bytes are reduced with short_fn:
+ * slicing-by-8, or the crc32 instruction for CRC-32C.
+ */
+
+#define PCLMUL_FN __attribute__((target("pclmul")))
+
+PCLMUL_FN static inline __m128i fold(__m128i acc, __m128i k, __m128i next) {
+    __m128i lo = _mm_clmulepi64_si128(acc, k, 0x00);
+    __m128i hi = _mm_clmulepi64_si128(acc, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(lo, hi), next);
+}
+
+PCLMUL_FN static uint32_t crc_pclmul(const crc_params_t *p, uint32_t crc, const uint8_t *d, size_t n) {
+    if (n < 128) {
+        return p->short_fn(p, crc, d, n);
+    }
+    const __m128i k4 = _mm_set_epi64x((long long)p->fold4[1], (long long)p->fold4[0]);
+    const __m128i k1 = _mm_set_epi64x((long long)p->fold1[1], (long long)p->fold1[0]);
+
+    // The running register is the same as XORing it into the first 32 bits
+    __m128i x0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)d), _mm_cvtsi32_si128((int)crc));
+    __m128i x1 = _mm_loadu_si128((const __m128i*)(d + 16));
+    __m128i x2 = _mm_loadu_si128((const __m128i*)(d + 32));
+    __m128i x3 = _mm_loadu_si128((const __m128i*)(d + 48));
+    d += 64;
+    n -= 64;
+
+    while (n >= 64) {
+        x0 = fold(x0, k4, _mm_loadu_si128((const __m128i*)d));
+        x1 = fold(x1, k4, _mm_loadu_si128((const __m128i*)(d + 16)));
+        x2 = fold(x2, k4, _mm_loadu_si128((const __m128i*)(d + 32)));
+        x3 = fold(x3, k4, _mm_loadu_si128((const __m128i*)(d + 48)));
+        d += 64;
+        n -= 64;
+    }
+
+    x0 = fold(x0, k1, x1);
+    x0 = fold(x0, k1, x2);
+    x0 = fold(x0, k1, x3);
+    while (n >= 16) {
+        x0 = fold(x0, k1, _mm_loadu_si128((const __m128i*)d));
+        d += 16;
+        n -= 16;
+    }
+
+    // x0 is now a 16-byte message with the same CRC (from a zero register)
+    uint8_t folded[16];
+    _mm_storeu_si128((__m128i*)folded, x0);
+    crc = p->short_fn(p, 0, folded, sizeof(folded));
+    return p->short_fn(p, crc, d, n);
+}
+
+#endif /* CRC_X86_64 */
+
+/* =============================================================================
+ * SECTION 5: Runtime dispatch and public API
+ * ============================================================================= */
+
+static pthread_once_t tables_once = PTHREAD_ONCE_INIT;
+static _Atomic(crc_fn) crc_active[CRC_ALGO_COUNT];
+static _Atomic crc_impl_t crc_active_impl[CRC_ALGO_COUNT];
+
+static crc_fn impl_fn(crc_algo_t algo, crc_impl_t impl) {
+    switch (impl) {
+    case CRC_IMPL_BYTEWISE:
+        return crc_bytewise;
+    case CRC_IMPL_SLICE8:
+        return crc_slice8;
+#if CRC_X86_64
+    case CRC_IMPL_SSE42:
+        return algo == CRC32C && __builtin_cpu_supports("sse4.2") ? crc_sse42 : NULL;
+    case CRC_IMPL_PCLMUL:
+        return crc_params[algo].reflected && crc_params[algo].width == 32 &&
+               __builtin_cpu_supports("pclmul") ? crc_pclmul : NULL;
+#endif
+    default:
+        (void)algo;
+        return NULL;
+    }
+}
+
+int crc_select(crc_algo_t algo, crc_impl_t impl) {
+    if ((unsigned)algo >= CRC_ALGO_COUNT) {
+        return -1;
+    }
+    crc_fn fn = impl_fn(algo, impl);
+    if (fn == NULL) {
+        return -1;
+    }
+    pthread_once(&tables_once, build_tables);
+    atomic_store_explicit(&crc_active_impl[algo], impl, memory_order_relaxed);
+    // Release: a thread that sees fn also sees the finished tables
+    atomic_store_explicit(&crc_active[algo], fn, memory_order_release);
+    return 0;
+}
+
+// Preference per algorithm, best first (see crc_bench for the numbers)
+static const crc_impl_t crc_preference[CRC_ALGO_COUNT][CRC_IMPL_COUNT] = {
+    [CRC16_CCITT_FALSE] = { CRC_IMPL_SLICE8, CRC_IMPL_BYTEWISE, CRC_IMPL_BYTEWISE, CRC_IMPL_BYTEWISE },
+    [CRC32]             = { CRC_IMPL_PCLMUL, CRC_IMPL_SLICE8, CRC_IMPL_BYTEWISE, CRC_IMPL_BYTEWISE },
+    [CRC32C]            = { CRC_IMPL_PCLMUL, CRC_IMPL_SSE42, CRC_IMPL_SLICE8, CRC_IMPL_BYTEWISE },
+};
+
+static crc_fn crc_resolve(crc_algo_t algo) {
+    crc_fn fn = atomic_load_explicit(&crc_active[algo], memory_order_acquire);
+    if (__builtin_expect(fn != NULL, 1)) {
+        return fn;
+    }
+    for (int i = 0; i < CRC_IMPL_COUNT; i++) {
+        if (crc_select(algo, crc_preference[algo][i]) == 0) {
+            break;
+        }
+    }
+    return atomic_load_explicit(&crc_active[algo], memory_order_acquire);
+}
+
+crc_impl_t crc_impl(crc_algo_t algo) {
+    crc_resolve(algo);
+    return atomic_load_explicit(&crc_active_impl[algo], memory_order_relaxed);
+}
+
+uint32_t crc_init(crc_algo_t algo) {
+    return crc_params[algo].init;
+}
+
+uint32_t crc_update(crc_algo_t algo, uint32_t crc, const void *data, size_t len) {
+    return crc_resolve(algo)(&crc_params[algo], crc, data, len);
+}
+
+uint32_t crc_final(crc_algo_t algo, uint32_t crc) {
+    return crc ^ crc_params[algo].xorout;
+}
+
+uint32_t crc_compute(crc_algo_t algo, const void *data, size_t len) {
+    return crc_final(algo, crc_update(algo, crc_init(algo), data, len));
+}
+
+uint32_t crc_check_value(crc_algo_t algo) {
+    return crc_params[algo].check;
+}
+
+const char *crc_algo_name(crc_algo_t algo) {
+    return (unsigned)algo < CRC_ALGO_COUNT ? crc_params[algo].name : "?";
+}
+
+const char *crc_impl_name(crc_impl_t impl) {
+    static const char *const names[CRC_IMPL_COUNT] = { "bytewise", "slice8", "sse4.2", "pclmul" };
+    return (unsigned)impl < CRC_IMPL_COUNT ? names[impl] : "?";
+}
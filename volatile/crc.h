@@ -0,0 +1,87 @@
+#ifndef CRC_H
+#define CRC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* =============================================================================
+ * CRC Engine for Serial Frames
+ * =============================================================================
+ * Three CRCs commonly used on UART links, each with several implementations
+ * that all produce identical results:
+ *
+ *   CRC16_CCITT_FALSE  poly 0x1021, init 0xFFFF, MSB-first   check 0x29B1
+ *   CRC32              poly 0x04C11DB7, reflected (Ethernet, zlib)  check 0xCBF43926
+ *   CRC32C             poly 0x1EDC6F41, reflected (Castagnoli)      check 0xE3069283
+ *
+ *   CRC_IMPL_BYTEWISE  one 256-entry table lookup per byte
+ *   CRC_IMPL_SLICE8    eight tables, eight bytes per step
+ *   CRC_IMPL_SSE42     the SSE4.2 crc32 instruction (CRC32C only)
+ *   CRC_IMPL_PCLMUL    carry-less multiply folding, 64 bytes per step
+ *                      (reflected CRC32/CRC32C only)
+ *
+ * The fastest implementation the CPU supports is picked on first use;
+ * crc_select() overrides it. The API is incremental, so a frame can be
+ * checksummed as its bytes arrive from UART_IRQHandler or the DMA callback:
+ *
+ *     uint32_t crc = crc_init(CRC32);
+ *     crc = crc_update(CRC32, crc, chunk1, len1);
+ *     crc = crc_update(CRC32, crc, chunk2, len2);
+ *     uint32_t value = crc_final(CRC32, crc);
+ */
+
+typedef enum {
+    CRC16_CCITT_FALSE = 0,
+    CRC32,
+    CRC32C,
+    CRC_ALGO_COUNT
+} crc_algo_t;
+
+typedef enum {
+    CRC_IMPL_BYTEWISE = 0,
+    CRC_IMPL_SLICE8,
+    CRC_IMPL_SSE42,
+    CRC_IMPL_PCLMUL,
+    CRC_IMPL_COUNT
+} crc_impl_t;
+
+/**
+ * @brief Register value before the first byte
+ */
+uint32_t crc_init(crc_algo_t algo);
+
+/**
+ * @brief Feed len bytes into a running CRC register
+ */
+uint32_t crc_update(crc_algo_t algo, uint32_t crc, const void *data, size_t len);
+
+/**
+ * @brief Turn the register into the transmitted CRC value
+ */
+uint32_t crc_final(crc_algo_t algo, uint32_t crc);
+
+/**
+ * @brief One-shot CRC of a whole buffer
+ */
+uint32_t crc_compute(crc_algo_t algo, const void *data, size_t len);
+
+/**
+ * @brief Catalogue check value: the CRC of the ASCII string "123456789"
+ */
+uint32_t crc_check_value(crc_algo_t algo);
+
+/**
+ * @brief Force an implementation for one algorithm
+ * @return 0 on success, -1 if it does not exist for algo or the CPU lacks it
+ */
+int crc_select(crc_algo_t algo, crc_impl_t impl);
+
+/**
+ * @brief Implementation in use for algo (resolving it on first call)
+ */
+crc_impl_t crc_impl(crc_algo_t algo);
+
+const char *crc_algo_name(crc_algo_t algo);
+const char *crc_impl_name(crc_impl_t impl);
+
+#endif /* CRC_H */
@@ -0,0 +1,177 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "crc.h"
+
+/* =============================================================================
+ * SECTION 1: Test vectors and cross-checks
+ * ============================================================================= */
+
+static int failures;
+
+static uint32_t rng_state = 0xC0FFEE;
+
+static uint32_t rnd(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void check_vectors(void) {
+    static uint8_t buf[70000 + 16];
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)rnd();
+    }
+
+    for (int a = 0; a < CRC_ALGO_COUNT; a++) {
+        // Reference results from the bytewise implementation
+        crc_select((crc_algo_t)a, CRC_IMPL_BYTEWISE);
+        enum { CASES = 400 };
+        size_t offs[CASES], lens[CASES];
+        uint32_t expect[CASES];
+        for (int c = 0; c < CASES; c++) {
+            offs[c] = rnd() % 16;       // Every misalignment
+            lens[c] = c < 300 ? (size_t)c : rnd() % 70000;
+            expect[c] = crc_compute((crc_algo_t)a, buf + offs[c], lens[c]);
+        }
+
+        for (int impl = 0; impl < CRC_IMPL_COUNT; impl++) {
+            if (crc_select((crc_algo_t)a, (crc_impl_t)impl) != 0) {
+                continue;
+            }
+            int before = failures;
+            uint32_t check = crc_compute((crc_algo_t)a, "123456789", 9);
+            if (check != crc_check_value((crc_algo_t)a)) {
+                printf("  FAIL %s/%s: check 0x%08X, want 0x%08X\n", crc_algo_name((crc_algo_t)a),
+                       crc_impl_name((crc_impl_t)impl), check, crc_check_value((crc_algo_t)a));
+                failures++;
+            }
+            for (int c = 0; c < CASES; c++) {
+                // One-shot, then the same bytes in random-sized pieces
+                uint32_t one = crc_compute((crc_algo_t)a, buf + offs[c], lens[c]);
+                uint32_t crc = crc_init((crc_algo_t)a);
+                size_t done = 0;
+                while (done < lens[c]) {
+                    size_t piece = 1 + rnd() % (rnd() % 2 ? 7 : 3000);
+                    piece = piece < lens[c] - done ? piece : lens[c] - done;
+                    crc = crc_update((crc_algo_t)a, crc, buf + offs[c] + done, piece);
+                    done += piece;
+                }
+                uint32_t streamed = crc_final((crc_algo_t)a, crc);
+                if (one != expect[c] || streamed != expect[c]) {
+                    if (failures++ < 10) {
+                        printf("  FAIL %s/%s len %zu off %zu\n", crc_algo_name((crc_algo_t)a),
+                               crc_impl_name((crc_impl_t)impl), lens[c], offs[c]);
+                    }
+                }
+            }
+            printf("  %-20s %-9s check 0x%08X  %s\n", crc_algo_name((crc_algo_t)a),
+                   crc_impl_name((crc_impl_t)impl), check, failures == before ? "ok" : "FAILED");
+        }
+    }
+}
+
+/* =============================================================================
+ * SECTION 2: A CRC-protected UART frame
+ * =============================================================================
+ * [len][payload...][crc hi][crc lo] with CRC-16/CCITT-FALSE over len and
+ * payload. The receiver updates the CRC one byte at a time from the RX
+ * interrupt; running the CRC over the whole frame, CRC included, leaves 0.
+ */
+
+static void uart_frame_example(void) {
+    uint8_t frame[2 + 32 + 2];
+    const char *payload = "TEMP=23.5;HUM=41;V=3.29";
+    size_t n = strlen(payload);
+
+    frame[0] = (uint8_t)n;
+    memcpy(frame + 1, payload, n);
+    uint16_t crc = (uint16_t)crc_compute(CRC16_CCITT_FALSE, frame, n + 1);
+    frame[n + 1] = (uint8_t)(crc >> 8);
+    frame[n + 2] = (uint8_t)crc;
+    size_t frame_len = n + 3;
+
+    // Receiver: one crc_update per byte, as UART_IRQHandler would do it
+    uint32_t rx = crc_init(CRC16_CCITT_FALSE);
+    for (size_t i = 0; i < frame_len; i++) {
+        rx = crc_update(CRC16_CCITT_FALSE, rx, &frame[i], 1);
+    }
+    printf("\nUART frame \"%s\": CRC 0x%04X, receiver residue 0x%04X (%s)\n", payload, crc,
+           crc_final(CRC16_CCITT_FALSE, rx), crc_final(CRC16_CCITT_FALSE, rx) == 0 ? "accepted" : "rejected");
+
+    frame[5] ^= 0x04;       // One flipped bit on the wire
+    printf("Same frame with one bit flipped: residue 0x%04X (%s)\n",
+           crc_compute(CRC16_CCITT_FALSE, frame, frame_len),
+           crc_compute(CRC16_CCITT_FALSE, frame, frame_len) == 0 ? "accepted" : "rejected");
+    if (crc_final(CRC16_CCITT_FALSE, rx) != 0 || crc_compute(CRC16_CCITT_FALSE, frame, frame_len) == 0) {
+        failures++;
+    }
+}
+
+/* =============================================================================
+ * SECTION 3: Throughput
+ * ============================================================================= */
+
+#define BENCH_BYTES (256u << 20)
+
+static double seconds_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void throughput(void) {
+    static const size_t sizes[] = { 16, 64, 256, 1500, 65536 };
+    enum { NSIZES = sizeof(sizes) / sizeof(sizes[0]) };
+    uint8_t *buf = malloc(65536);
+    for (size_t i = 0; i < 65536; i++) {
+        buf[i] = (uint8_t)rnd();
+    }
+
+    printf("\nThroughput in GB/s by frame size:\n");
+    printf("%-20s %-9s", "algorithm", "impl");
+    for (int s = 0; s < NSIZES; s++) {
+        printf(" %8zuB", sizes[s]);
+    }
+    printf("\n");
+
+    for (int a = 0; a < CRC_ALGO_COUNT; a++) {
+        for (int impl = 0; impl < CRC_IMPL_COUNT; impl++) {
+            if (crc_select((crc_algo_t)a, (crc_impl_t)impl) != 0) {
+                continue;
+            }
+            printf("%-20s %-9s", crc_algo_name((crc_algo_t)a), crc_impl_name((crc_impl_t)impl));
+            for (int s = 0; s < NSIZES; s++) {
+                size_t reps = (impl == CRC_IMPL_BYTEWISE ? BENCH_BYTES / 8 : BENCH_BYTES) / sizes[s];
+                uint32_t sink = 0;
+                double t0 = seconds_now();
+                for (size_t r = 0; r < reps; r++) {
+                    sink += crc_compute((crc_algo_t)a, buf, sizes[s]);
+                    __asm__ volatile("" : : "r"(buf) : "memory");
+                }
+                double t1 = seconds_now();
+                __asm__ volatile("" : : "r"(sink));
+                printf(" %9.2f", (double)(reps * sizes[s]) / (t1 - t0) / 1e9);
+            }
+            printf("\n");
+        }
+    }
+    free(buf);
+}
+
+int main(void) {
+    printf("Default implementations on this CPU:");
+    for (int a = 0; a < CRC_ALGO_COUNT; a++) {
+        printf(" %s=%s", crc_algo_name((crc_algo_t)a), crc_impl_name(crc_impl((crc_algo_t)a)));
+    }
+    printf("\n\nCRC test vectors, all implementations (one-shot and streamed in random pieces):\n");
+    check_vectors();
+    uart_frame_example();
+    throughput();
+
+    return failures != 0;
+}
@@ -0,0 +1,243 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* =============================================================================
+ * SECTION 1: GPIO Register Definitions (same layout as volatile.c)
+ * ============================================================================= */
+
+typedef struct {
+    volatile uint32_t INPUT;        // 0x00: Input data register
+    volatile uint32_t OUTPUT;       // 0x04: Output data register
+    volatile uint32_t DIRECTION;    // 0x08: Pin direction (0=input, 1=output)
+    volatile uint32_t PULLUP;       // 0x0C: Pull-up enable
+    volatile uint32_t INTERRUPT;    // 0x10: Interrupt status/clear
+    volatile uint32_t SET;          // 0x14: Write-only, 1 = drive pin high
+    volatile uint32_t CLEAR;        // 0x18: Write-only, 1 = drive pin low
+    volatile uint32_t BSRR;         // 0x1C: Write-only, bits 0-15 set / 16-31 reset pins 0-15
+} GPIO_TypeDef;
+
+// Bit-banged SPI (mode 0, MSB first) pin assignment
+#define PIN_SCK     (1u << 0)
+#define PIN_MOSI    (1u << 1)
+#define PIN_MISO    (1u << 2)
+#define PIN_CS      (1u << 3)
+
+/* =============================================================================
+ * SECTION 2: Port Model with an SPI Slave Attached
+ * =============================================================================
+ * A RAM-backed register block cannot react to writes by itself, so every
+ * driver write goes through GPIO_WR(), which also calls gpio_sim_bus(): the
+ * model applies the write-only SET/CLEAR/BSRR registers to OUTPUT and lets
+ * the SPI slave watch the pins.
+ */
+
+static GPIO_TypeDef sim_gpio;
+#define GPIO    (&sim_gpio)
+
+static struct {
+    uint32_t last_output;
+    uint8_t  tx[4096];          // What the slave shifts out on MISO
+    uint8_t  rx[4096];          // What the slave sampled on MOSI
+    size_t   rx_bits;
+    size_t   tx_bits;
+} slave;
+
+static uint64_t reg_reads;
+static uint64_t reg_writes;
+
+static void slave_drive_miso(void) {
+    uint8_t byte = slave.tx[(slave.tx_bits / 8) % sizeof(slave.tx)];
+    bool bit = (byte >> (7 - slave.tx_bits % 8)) & 1;
+    GPIO->INPUT = bit ? (GPIO->INPUT | PIN_MISO) : (GPIO->INPUT & ~PIN_MISO);
+}
+
+static void gpio_sim_bus(void) {
+    uint32_t out = GPIO->OUTPUT;
+    uint32_t bsrr = GPIO->BSRR;
+
+    // Write-only registers: apply and read back as zero, set wins over reset
+    out &= ~GPIO->CLEAR;
+    out |= GPIO->SET;
+    out &= ~(bsrr >> 16);
+    out |= bsrr & 0xFFFF;
+    GPIO->SET = GPIO->CLEAR = GPIO->BSRR = 0;
+    GPIO->OUTPUT = out;
+
+    uint32_t prev = slave.last_output;
+    slave.last_output = out;
+
+    if (out & PIN_CS) {
+        return;                                     // Slave not selected
+    }
+    if (prev & PIN_CS) {
+        slave_drive_miso();                         // CS fell: present first bit
+        return;
+    }
+    if (!(prev & PIN_SCK) && (out & PIN_SCK)) {     // Rising edge: sample MOSI
+        size_t i = (slave.rx_bits / 8) % sizeof(slave.rx);
+        slave.rx[i] = (uint8_t)((slave.rx[i] << 1) | ((out & PIN_MOSI) ? 1 : 0));
+        slave.rx_bits++;
+    } else if ((prev & PIN_SCK) && !(out & PIN_SCK)) {  // Falling edge: shift MISO
+        slave.tx_bits++;
+        slave_drive_miso();
+    }
+}
+
+#define GPIO_RD(reg)        (reg_reads++, GPIO->reg)
+#define GPIO_WR(reg, val)   do { reg_writes++; GPIO->reg = (val); gpio_sim_bus(); } while (0)
+
+/* =============================================================================
+ * SECTION 3: Four Ways to Bit-Bang One SPI Byte
+ * ============================================================================= */
+
+/**
+ * @brief Read-modify-write on OUTPUT, as in gpio_operations_example()
+ * 7 accesses per bit, and each RMW can lose a concurrent ISR update.
+ */
+static uint8_t spi_xfer_rmw(uint8_t out) {
+    uint8_t in = 0;
+    for (int bit = 7; bit >= 0; bit--) {
+        if (out & (1u << bit)) {
+            GPIO_WR(OUTPUT, GPIO_RD(OUTPUT) | PIN_MOSI);
+        } else {
+            GPIO_WR(OUTPUT, GPIO_RD(OUTPUT) & ~PIN_MOSI);
+        }
+        GPIO_WR(OUTPUT, GPIO_RD(OUTPUT) | PIN_SCK);
+        in = (uint8_t)((in << 1) | ((GPIO_RD(INPUT) & PIN_MISO) ? 1 : 0));
+        GPIO_WR(OUTPUT, GPIO_RD(OUTPUT) & ~PIN_SCK);
+    }
+    return in;
+}
+
+/**
+ * @brief Write-only SET/CLEAR registers: 4 accesses per bit, ISR-safe
+ */
+static uint8_t spi_xfer_set_clear(uint8_t out) {
+    uint8_t in = 0;
+    for (int bit = 7; bit >= 0; bit--) {
+        if (out & (1u << bit)) {
+            GPIO_WR(SET, PIN_MOSI);
+        } else {
+            GPIO_WR(CLEAR, PIN_MOSI);
+        }
+        GPIO_WR(SET, PIN_SCK);
+        in = (uint8_t)((in << 1) | ((GPIO_RD(INPUT) & PIN_MISO) ? 1 : 0));
+        GPIO_WR(CLEAR, PIN_SCK);
+    }
+    return in;
+}
+
+/**
+ * @brief Batched BSRR: drop SCK and set up MOSI in one write - 3 accesses per bit
+ */
+static uint8_t spi_xfer_bsrr(uint8_t out) {
+    uint8_t in = 0;
+    for (int bit = 7; bit >= 0; bit--) {
+        uint32_t mosi = (out & (1u << bit)) ? PIN_MOSI : 0;
+        // Set MOSI if 1, reset MOSI if 0, reset SCK - all in one bus cycle
+        GPIO_WR(BSRR, mosi | ((PIN_SCK | (PIN_MOSI & ~mosi)) << 16));
+        GPIO_WR(BSRR, PIN_SCK);
+        in = (uint8_t)((in << 1) | ((GPIO_RD(INPUT) & PIN_MISO) ? 1 : 0));
+    }
+    GPIO_WR(BSRR, PIN_SCK << 16);
+    return in;
+}
+
+/**
+ * @brief Shadowed OUTPUT writes: also 3 accesses per bit, but it overwrites
+ * every other pin of the port - only valid if nothing else owns that port.
+ */
+static uint32_t output_shadow;
+
+static uint8_t spi_xfer_shadow(uint8_t out) {
+    uint8_t in = 0;
+    uint32_t o = output_shadow;
+    for (int bit = 7; bit >= 0; bit--) {
+        o = (out & (1u << bit)) ? (o | PIN_MOSI) : (o & ~PIN_MOSI);
+        o &= ~PIN_SCK;
+        GPIO_WR(OUTPUT, o);
+        o |= PIN_SCK;
+        GPIO_WR(OUTPUT, o);
+        in = (uint8_t)((in << 1) | ((GPIO_RD(INPUT) & PIN_MISO) ? 1 : 0));
+    }
+    o &= ~PIN_SCK;
+    GPIO_WR(OUTPUT, o);
+    output_shadow = o;
+    return in;
+}
+
+/* =============================================================================
+ * SECTION 4: Benchmark
+ * ============================================================================= */
+
+#define BENCH_BYTES     (1u << 20)
+
+typedef uint8_t (*spi_xfer_fn)(uint8_t out);
+
+static uint8_t master_tx[4096];
+
+static double seconds_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void bench_spi(const char *name, spi_xfer_fn xfer) {
+    memset(&slave, 0, sizeof(slave));
+    memset(&sim_gpio, 0, sizeof(sim_gpio));
+    for (size_t i = 0; i < sizeof(slave.tx); i++) {
+        slave.tx[i] = (uint8_t)(i * 13u + 5u);
+    }
+    GPIO->DIRECTION = PIN_SCK | PIN_MOSI | PIN_CS;
+    GPIO->OUTPUT = PIN_CS;                      // Idle: CS high, SCK low
+    slave.last_output = PIN_CS;
+    output_shadow = PIN_CS;
+    reg_reads = reg_writes = 0;
+
+    bool ok = true;
+    double t0 = seconds_now();
+
+    GPIO_WR(CLEAR, PIN_CS);
+    output_shadow &= ~PIN_CS;
+    for (size_t i = 0; i < BENCH_BYTES; i++) {
+        size_t k = i % sizeof(master_tx);
+        uint8_t in = xfer(master_tx[k]);
+        ok &= (in == slave.tx[k]);
+    }
+    GPIO_WR(SET, PIN_CS);
+    output_shadow |= PIN_CS;
+
+    double elapsed = seconds_now() - t0;
+    ok &= (slave.rx_bits == BENCH_BYTES * 8u);
+    ok &= memcmp(slave.rx, master_tx, sizeof(master_tx)) == 0;
+
+    double bits = BENCH_BYTES * 8.0;
+    printf("%-22s %5.2f reads/bit %5.2f writes/bit %5.2f accesses/bit %7.2f Mbit/s  %s\n",
+           name, (double)reg_reads / bits, (double)reg_writes / bits,
+           (double)(reg_reads + reg_writes) / bits, bits / elapsed / 1e6,
+           ok ? "data OK" : "DATA MISMATCH");
+}
+
+int main(void) {
+    printf("=======================================================\n");
+    printf("   BIT-BANGED SPI: READ-MODIFY-WRITE vs SET/CLEAR/BSRR\n");
+    printf("=======================================================\n");
+    printf("%u bytes full duplex; throughput includes the port model.\n\n", BENCH_BYTES);
+
+    for (size_t i = 0; i < sizeof(master_tx); i++) {
+        master_tx[i] = (uint8_t)(i * 7u + 1u);
+    }
+
+    bench_spi("OUTPUT read-mod-write", spi_xfer_rmw);
+    bench_spi("SET/CLEAR registers", spi_xfer_set_clear);
+    bench_spi("BSRR batched update", spi_xfer_bsrr);
+    bench_spi("OUTPUT shadow (unsafe)", spi_xfer_shadow);
+
+    printf("\nOn real hardware each access is an uncached bus transaction,\n");
+    printf("so accesses/bit is what bounds the achievable SCK frequency.\n");
+    return 0;
+}
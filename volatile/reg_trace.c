@@ -0,0 +1,219 @@
+#define _GNU_SOURCE
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#ifndef REG_TRACE
+#define REG_TRACE
+#endif
+#include "reg_trace.h"
+
+/* =============================================================================
+ * Per-Thread Trace Ring
+ * =============================================================================
+ * Each thread owns one ring. A slot is claimed with an atomic increment of the
+ * thread's own head before it is filled, so an ISR simulated by a signal
+ * handler on the same thread can interrupt a record in progress without
+ * corrupting it. No locks are taken on the access path.
+ *
+ * The rings live in a static pool, claimed with one atomic increment. The
+ * first traced access of a thread may be in a signal handler, where malloc()
+ * and atexit() are not safe to call. Untouched rings cost no RAM beyond the
+ * address space, as bss pages are only backed when written.
+ */
+
+#define RING_SIZE   (1u << REG_TRACE_RING_BITS)
+#define RING_MASK   (RING_SIZE - 1)
+#define MAX_NAMES   64
+
+typedef struct {
+    uint64_t thread_id;
+    _Atomic uint64_t head;
+    reg_trace_record_t records[RING_SIZE];
+} trace_ring_t;
+
+static trace_ring_t ring_pool[REG_TRACE_MAX_THREADS];
+static _Atomic uint32_t ring_count;
+static _Thread_local trace_ring_t *my_ring;
+static _Thread_local int no_ring;              // Pool was full for this thread
+
+static reg_trace_name_t names[MAX_NAMES];
+static _Atomic uint32_t name_count;
+
+// Interned __FILE__ pointers; the index goes in each record
+static _Atomic(const char *) files[REG_TRACE_MAX_FILES];
+static _Thread_local uint8_t last_file;
+
+static inline uint64_t trace_timestamp(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static void dump_at_exit(void) {
+    const char *path = getenv("REG_TRACE_FILE");
+    reg_trace_dump(path != NULL ? path : "reg_trace.bin");
+}
+
+// Registered before main(), not on the first access, which may be in an ISR
+__attribute__((constructor))
+static void reg_trace_init(void) {
+    atexit(dump_at_exit);
+}
+
+static trace_ring_t *ring_claim(void) {
+    uint32_t i = atomic_fetch_add_explicit(&ring_count, 1, memory_order_relaxed);
+    if (i >= REG_TRACE_MAX_THREADS) {
+        atomic_store_explicit(&ring_count, REG_TRACE_MAX_THREADS, memory_order_relaxed);
+        no_ring = 1;
+        return NULL;
+    }
+    ring_pool[i].thread_id = (uint64_t)syscall(SYS_gettid);
+    return &ring_pool[i];
+}
+
+/**
+ * @brief Index of `file` in the file table, adding it on first use
+ * Lock-free, so it is safe from a signal handler. Identical paths at
+ * different addresses (one per translation unit) get separate slots; the
+ * report merges them by name.
+ */
+static uint8_t file_id(const char *file) {
+    uint8_t last = last_file;
+    if (atomic_load_explicit(&files[last], memory_order_relaxed) == file) {
+        return last;
+    }
+    for (uint8_t i = 0; i < REG_TRACE_MAX_FILES; i++) {
+        const char *seen = atomic_load_explicit(&files[i], memory_order_relaxed);
+        if (seen == NULL && atomic_compare_exchange_strong(&files[i], &seen, file)) {
+            seen = file;
+        }
+        if (seen == file) {
+            last_file = i;
+            return i;
+        }
+    }
+    return REG_TRACE_MAX_FILES;     // Table full: reported as "?"
+}
+
+static inline void trace_record(const volatile void *reg, uint32_t value,
+                                const char *file, unsigned line, uint8_t op) {
+    trace_ring_t *ring = my_ring;
+    if (__builtin_expect(ring == NULL, 0)) {
+        if (no_ring) {
+            return;
+        }
+        ring = my_ring = ring_claim();
+        if (ring == NULL) {
+            return;
+        }
+    }
+    uint64_t slot = atomic_fetch_add_explicit(&ring->head, 1, memory_order_relaxed);
+    reg_trace_record_t *r = &ring->records[slot & RING_MASK];
+    r->timestamp = trace_timestamp();
+    r->address = (uint64_t)(uintptr_t)reg;
+    r->value = value;
+    r->line = (uint16_t)line;
+    r->op = op;
+    r->file = file_id(file);
+}
+
+uint32_t reg_trace_read32(const volatile uint32_t *reg, const char *file, unsigned line) {
+    uint32_t value = *reg;
+    trace_record(reg, value, file, line, REG_TRACE_OP_READ);
+    return value;
+}
+
+void reg_trace_write32(volatile uint32_t *reg, uint32_t value, const char *file, unsigned line) {
+    *reg = value;
+    trace_record(reg, value, file, line, REG_TRACE_OP_WRITE);
+}
+
+/**
+ * @brief Attach a readable name to a register address for the report
+ */
+void reg_trace_name(const volatile void *reg, const char *name) {
+    uint32_t i = atomic_fetch_add(&name_count, 1);
+    if (i >= MAX_NAMES) {
+        atomic_store(&name_count, MAX_NAMES);
+        return;
+    }
+    names[i].address = (uint64_t)(uintptr_t)reg;
+    strncpy(names[i].name, name, REG_TRACE_NAME_MAX - 1);
+    names[i].name[REG_TRACE_NAME_MAX - 1] = '\0';
+}
+
+/**
+ * @brief Write every thread's ring to `path`
+ * Records of a thread that is still tracing while the dump runs may be torn;
+ * call it at exit or once the traced threads are quiescent.
+ * @return 0 on success, -1 on I/O error
+ */
+int reg_trace_dump(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        perror("reg_trace_dump");
+        return -1;
+    }
+
+    uint32_t nnames = atomic_load(&name_count);
+    uint32_t nthreads = atomic_load(&ring_count);
+    uint32_t nfiles = 0;
+    while (nfiles < REG_TRACE_MAX_FILES && atomic_load(&files[nfiles]) != NULL) {
+        nfiles++;
+    }
+
+    reg_trace_file_header_t hdr = {
+        .magic = REG_TRACE_MAGIC,
+        .version = REG_TRACE_VERSION,
+        .record_size = sizeof(reg_trace_record_t),
+        .name_count = nnames,
+        .thread_count = nthreads,
+        .file_count = nfiles,
+    };
+    int ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+    ok &= fwrite(names, sizeof(names[0]), nnames, f) == nnames;
+
+    for (uint32_t i = 0; i < nfiles; i++) {
+        // Keep the tail of long paths, it is the part that tells files apart
+        reg_trace_source_t src = { { 0 } };
+        const char *path = atomic_load(&files[i]);
+        size_t len = strlen(path);
+        if (len >= REG_TRACE_PATH_MAX) {
+            path += len - (REG_TRACE_PATH_MAX - 1);
+        }
+        strncpy(src.path, path, REG_TRACE_PATH_MAX - 1);
+        ok &= fwrite(&src, sizeof(src), 1, f) == 1;
+    }
+
+    for (uint32_t t = 0; t < nthreads; t++) {
+        trace_ring_t *r = &ring_pool[t];
+        uint64_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+        uint64_t count = head < RING_SIZE ? head : RING_SIZE;
+        reg_trace_thread_header_t th = { r->thread_id, head, count };
+        ok &= fwrite(&th, sizeof(th), 1, f) == 1;
+        // Oldest record first
+        for (uint64_t i = head - count; i < head; i++) {
+            ok &= fwrite(&r->records[i & RING_MASK], sizeof(reg_trace_record_t), 1, f) == 1;
+        }
+    }
+
+    ok &= fclose(f) == 0;
+    if (!ok) {
+        fprintf(stderr, "reg_trace_dump: write to %s failed\n", path);
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+#ifndef REG_TRACE_H
+#define REG_TRACE_H
+
+#include <stdint.h>
+
+/* =============================================================================
+ * Register Access Tracer
+ * =============================================================================
+ * Drivers access peripheral registers through REG_RD()/REG_WR() instead of
+ * touching the volatile struct fields directly:
+ *
+ *     REG_WR(GPIO->OUTPUT, REG_RD(GPIO->OUTPUT) | (1 << 5));
+ *
+ * Without -DREG_TRACE the macros expand to the plain volatile access, so the
+ * generated code is identical to writing GPIO->OUTPUT |= (1 << 5).
+ *
+ * With -DREG_TRACE (and reg_trace.c linked in) every access is appended to a
+ * per-thread ring of (timestamp, address, value, R/W, source file and line)
+ * records. The rings are static, so the first traced access of a thread may
+ * come from a signal handler. They are dumped to $REG_TRACE_FILE (default
+ * reg_trace.bin) at exit and summarised offline by reg_trace_report.
+ */
+
+#define REG_TRACE_MAGIC     0x43525452u     // "RTRC"
+#define REG_TRACE_VERSION   2u
+#ifndef REG_TRACE_RING_BITS
+#define REG_TRACE_RING_BITS 16              // 64k records per thread
+#endif
+#ifndef REG_TRACE_MAX_THREADS
+#define REG_TRACE_MAX_THREADS 8             // Threads beyond this are not traced
+#endif
+#define REG_TRACE_NAME_MAX  32
+#define REG_TRACE_MAX_FILES 255             // Source files with traced accesses
+#define REG_TRACE_PATH_MAX  64
+
+#define REG_TRACE_OP_READ   0
+#define REG_TRACE_OP_WRITE  1
+
+typedef struct {
+    uint64_t timestamp;     // TSC (x86) or CLOCK_MONOTONIC nanoseconds
+    uint64_t address;
+    uint32_t value;
+    uint16_t line;          // Source line of the access
+    uint8_t  op;            // REG_TRACE_OP_*
+    uint8_t  file;          // Index into the file table
+} reg_trace_record_t;
+
+// Dump file layout: header, name table, file table, then per thread a header
+// plus records
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t name_count;
+    uint32_t thread_count;
+    uint32_t file_count;
+} reg_trace_file_header_t;
+
+typedef struct {
+    uint64_t address;
+    char name[REG_TRACE_NAME_MAX];
+} reg_trace_name_t;
+
+typedef struct {
+    char path[REG_TRACE_PATH_MAX];          // __FILE__, truncated from the left
+} reg_trace_source_t;
+
+typedef struct {
+    uint64_t thread_id;
+    uint64_t total;         // Accesses made, including those overwritten in the ring
+    uint64_t records;       // Records that follow (<= ring size)
+} reg_trace_thread_header_t;
+
+#ifdef REG_TRACE
+
+uint32_t reg_trace_read32(const volatile uint32_t *reg, const char *file, unsigned line);
+void reg_trace_write32(volatile uint32_t *reg, uint32_t value, const char *file, unsigned line);
+void reg_trace_name(const volatile void *reg, const char *name);
+int reg_trace_dump(const char *path);
+
+#define REG_RD(reg)             reg_trace_read32(&(reg), __FILE__, __LINE__)
+#define REG_WR(reg, val)        reg_trace_write32(&(reg), (val), __FILE__, __LINE__)
+#define REG_TRACE_NAME(reg)     reg_trace_name(&(reg), #reg)
+
+#else
+
+#define REG_RD(reg)             (reg)
+#define REG_WR(reg, val)        ((void)((reg) = (val)))
+#define REG_TRACE_NAME(reg)     ((void)0)
+
+#endif /* REG_TRACE */
+
+#endif /* REG_TRACE_H */
@@ -0,0 +1,248 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "reg_trace.h"
+
+/* =============================================================================
+ * Offline summary of a reg_trace dump
+ * =============================================================================
+ * Usage: reg_trace_report [reg_trace.bin] [top_n]
+ *
+ * Prints per-register read/write counts, the hottest (file:line, register)
+ * pairs, and two kinds of MMIO traffic that are usually removable:
+ *  - redundant writes: the value written equals the last value seen
+ *  - repeated reads:   same value as the previous read, with no write between
+ *                      (expected for status polling, suspicious elsewhere)
+ */
+
+#define MAX_REGS    256
+#define MAX_SITES   1024
+
+typedef struct {
+    uint64_t address;
+    uint64_t reads;
+    uint64_t writes;
+    uint64_t redundant_writes;
+    uint64_t repeated_reads;
+    // Replay state, reset per thread
+    uint32_t last_value;
+    int      have_value;
+    int      last_was_read;
+} reg_stat_t;
+
+typedef struct {
+    uint64_t address;
+    uint16_t line;
+    uint8_t  op;
+    uint8_t  file;      // First file table entry with this path
+    uint64_t count;
+    uint64_t redundant;
+} site_stat_t;
+
+static reg_trace_name_t *names;
+static uint32_t name_count;
+static reg_trace_source_t *files;
+static uint32_t file_count;
+static uint8_t file_alias[REG_TRACE_MAX_FILES + 1];
+static reg_stat_t regs[MAX_REGS];
+static size_t reg_count;
+static site_stat_t sites[MAX_SITES];
+static size_t site_count;
+
+static const char *reg_name(uint64_t address) {
+    static char buf[32];
+    for (uint32_t i = 0; i < name_count; i++) {
+        if (names[i].address == address) {
+            return names[i].name;
+        }
+    }
+    snprintf(buf, sizeof(buf), "0x%llx", (unsigned long long)address);
+    return buf;
+}
+
+static const char *file_name(uint8_t file) {
+    return file < file_count ? files[file].path : "?";
+}
+
+// The same __FILE__ string can be interned once per translation unit
+static void merge_file_aliases(void) {
+    for (uint32_t i = 0; i <= REG_TRACE_MAX_FILES; i++) {
+        file_alias[i] = (uint8_t)i;
+    }
+    for (uint32_t i = 0; i < file_count; i++) {
+        for (uint32_t j = 0; j < i; j++) {
+            if (strcmp(files[i].path, files[j].path) == 0) {
+                file_alias[i] = file_alias[j];
+                break;
+            }
+        }
+    }
+}
+
+static reg_stat_t *find_reg(uint64_t address) {
+    for (size_t i = 0; i < reg_count; i++) {
+        if (regs[i].address == address) {
+            return &regs[i];
+        }
+    }
+    if (reg_count == MAX_REGS) {
+        return NULL;
+    }
+    regs[reg_count].address = address;
+    return &regs[reg_count++];
+}
+
+static site_stat_t *find_site(uint64_t address, uint8_t file, uint16_t line, uint8_t op) {
+    for (size_t i = 0; i < site_count; i++) {
+        if (sites[i].address == address && sites[i].file == file && sites[i].line == line &&
+            sites[i].op == op) {
+            return &sites[i];
+        }
+    }
+    if (site_count == MAX_SITES) {
+        return NULL;
+    }
+    sites[site_count] = (site_stat_t){ .address = address, .line = line, .op = op, .file = file };
+    return &sites[site_count++];
+}
+
+static void account(const reg_trace_record_t *r) {
+    reg_stat_t *reg = find_reg(r->address);
+    site_stat_t *site = find_site(r->address, file_alias[r->file], r->line, r->op);
+    if (reg == NULL || site == NULL) {
+        return;
+    }
+    site->count++;
+
+    if (r->op == REG_TRACE_OP_WRITE) {
+        reg->writes++;
+        if (reg->have_value && reg->last_value == r->value) {
+            reg->redundant_writes++;
+            site->redundant++;
+        }
+        reg->last_was_read = 0;
+    } else {
+        reg->reads++;
+        if (reg->have_value && reg->last_was_read && reg->last_value == r->value) {
+            reg->repeated_reads++;
+            site->redundant++;
+        }
+        reg->last_was_read = 1;
+    }
+    reg->last_value = r->value;
+    reg->have_value = 1;
+}
+
+static int by_total_desc(const void *a, const void *b) {
+    const reg_stat_t *x = a, *y = b;
+    uint64_t tx = x->reads + x->writes, ty = y->reads + y->writes;
+    return (tx < ty) - (tx > ty);
+}
+
+static int by_count_desc(const void *a, const void *b) {
+    const site_stat_t *x = a, *y = b;
+    return (x->count < y->count) - (x->count > y->count);
+}
+
+int main(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : "reg_trace.bin";
+    size_t top_n = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : 20;
+
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    reg_trace_file_header_t hdr;
+    if (fread(&hdr, sizeof(hdr), 1, f) != 1 || hdr.magic != REG_TRACE_MAGIC ||
+        hdr.version != REG_TRACE_VERSION || hdr.record_size != sizeof(reg_trace_record_t)) {
+        fprintf(stderr, "%s: not a reg_trace v%u dump\n", path, REG_TRACE_VERSION);
+        return 1;
+    }
+
+    name_count = hdr.name_count;
+    names = calloc(name_count ? name_count : 1, sizeof(*names));
+    if (names == NULL || fread(names, sizeof(*names), name_count, f) != name_count) {
+        fprintf(stderr, "%s: truncated name table\n", path);
+        return 1;
+    }
+
+    file_count = hdr.file_count;
+    files = calloc(file_count ? file_count : 1, sizeof(*files));
+    if (file_count > REG_TRACE_MAX_FILES || files == NULL ||
+        fread(files, sizeof(*files), file_count, f) != file_count) {
+        fprintf(stderr, "%s: bad file table\n", path);
+        return 1;
+    }
+    for (uint32_t i = 0; i < file_count; i++) {
+        files[i].path[REG_TRACE_PATH_MAX - 1] = '\0';
+    }
+    merge_file_aliases();
+
+    uint64_t total = 0, kept = 0, first_ts = UINT64_MAX, last_ts = 0;
+    printf("Threads: %u\n", hdr.thread_count);
+    for (uint32_t t = 0; t < hdr.thread_count; t++) {
+        reg_trace_thread_header_t th;
+        if (fread(&th, sizeof(th), 1, f) != 1) {
+            fprintf(stderr, "%s: truncated thread header\n", path);
+            return 1;
+        }
+        printf("  tid %llu: %llu accesses (%llu in trace)\n", (unsigned long long)th.thread_id,
+               (unsigned long long)th.total, (unsigned long long)th.records);
+        total += th.total;
+        kept += th.records;
+
+        for (size_t i = 0; i < reg_count; i++) {
+            regs[i].have_value = 0;
+        }
+        for (uint64_t i = 0; i < th.records; i++) {
+            reg_trace_record_t r;
+            if (fread(&r, sizeof(r), 1, f) != 1) {
+                fprintf(stderr, "%s: truncated records\n", path);
+                return 1;
+            }
+            first_ts = r.timestamp < first_ts ? r.timestamp : first_ts;
+            last_ts = r.timestamp > last_ts ? r.timestamp : last_ts;
+            account(&r);
+        }
+    }
+    fclose(f);
+
+    if (kept < total) {
+        printf("Note: ring wrapped, statistics cover the last %llu of %llu accesses\n",
+               (unsigned long long)kept, (unsigned long long)total);
+    }
+    if (kept > 0) {
+        printf("Time span: %llu ticks\n", (unsigned long long)(last_ts - first_ts));
+    }
+
+    qsort(regs, reg_count, sizeof(regs[0]), by_total_desc);
+    printf("\n%-24s %10s %10s %7s %12s %12s\n", "Register", "Reads", "Writes", "Share",
+           "Redund. W", "Repeat R");
+    for (size_t i = 0; i < reg_count; i++) {
+        const reg_stat_t *r = &regs[i];
+        printf("%-24s %10llu %10llu %6.1f%% %12llu %12llu\n", reg_name(r->address),
+               (unsigned long long)r->reads, (unsigned long long)r->writes,
+               100.0 * (double)(r->reads + r->writes) / (double)(kept ? kept : 1),
+               (unsigned long long)r->redundant_writes, (unsigned long long)r->repeated_reads);
+    }
+
+    qsort(sites, site_count, sizeof(sites[0]), by_count_desc);
+    printf("\nHot spots (source line, register):\n");
+    printf("%-28s %-24s %2s %10s %10s\n", "Source", "Register", "Op", "Count", "Removable?");
+    for (size_t i = 0; i < site_count && i < top_n; i++) {
+        const site_stat_t *s = &sites[i];
+        char where[REG_TRACE_PATH_MAX + 8];
+        snprintf(where, sizeof(where), "%s:%u", file_name(s->file), s->line);
+        printf("%-28s %-24s %2s %10llu %10llu\n", where, reg_name(s->address),
+               s->op == REG_TRACE_OP_WRITE ? "W" : "R",
+               (unsigned long long)s->count, (unsigned long long)s->redundant);
+    }
+
+    free(names);
+    free(files);
+    return 0;
+}
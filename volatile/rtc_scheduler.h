@@ -0,0 +1,191 @@
+#ifndef RTC_SCHEDULER_H
+#define RTC_SCHEDULER_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/* =============================================================================
+ * Run-to-Completion Task Scheduler
+ * =============================================================================
+ * Cooperative, single stack, no RTOS:
+ *  - Tasks live in a static pool, one task per priority (0 = lowest, 31 = highest).
+ *  - ISRs call sched_post() to OR event bits into a task and mark it ready.
+ *  - sched_dispatch() picks the highest ready priority with a single
+ *    count-leading-zeros on the ready bitmap (O(1)) and runs it to completion.
+ *  - Every task accumulates run count, CPU time and post-to-start latency.
+ *
+ * The ready bitmap, event words and post timestamps are all 32-bit C11
+ * atomics, so they are lock-free wherever the CPU has 32-bit atomic RMW and
+ * safe to touch from a signal handler. On a Cortex-M3+ they compile to
+ * LDREX/STREX; on a Cortex-M0 (no exclusives, so GCC calls out to locking
+ * libatomic helpers) replace them with a short interrupt-disabled section.
+ * Keep 64-bit atomics out of this header: on 32-bit targets those are not
+ * lock-free and therefore not ISR-safe.
+ */
+
+#define SCHED_MAX_TASKS     32
+
+// Per-task run time and latency accounting costs three clock reads per event;
+// build with -DSCHED_ACCOUNTING=0 to drop it
+#ifndef SCHED_ACCOUNTING
+#define SCHED_ACCOUNTING    1
+#endif
+
+typedef void (*sched_handler_t)(void *arg, uint32_t events);
+
+typedef struct {
+    sched_handler_t handler;
+    void *arg;
+    const char *name;
+    _Atomic uint32_t events;            // Posted but not yet handled
+    _Atomic uint32_t posted_at;         // sched_ticks() of the first post since the last run
+    // Accounting, written by the dispatcher only
+    uint32_t runs;
+    uint64_t run_time_total;
+    uint64_t run_time_max;
+    uint64_t latency_total;
+    uint64_t latency_max;
+} sched_task_t;
+
+typedef struct {
+    _Atomic uint32_t ready;             // Bit n set = task of priority n has events
+    sched_task_t tasks[SCHED_MAX_TASKS];
+    uint64_t dispatches;
+} scheduler_t;
+
+/**
+ * @brief Time source for accounting, in nanoseconds
+ */
+static inline uint64_t sched_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Wrapping 32-bit timestamp for post-to-start latency
+ * Low bits of sched_now(); differences are exact up to 4.29 s. On target,
+ * DWT->CYCCNT serves the same purpose.
+ */
+static inline uint32_t sched_ticks(void) {
+    return (uint32_t)sched_now();
+}
+
+static inline void sched_init(scheduler_t *s) {
+    atomic_store(&s->ready, 0);
+    s->dispatches = 0;
+    for (int i = 0; i < SCHED_MAX_TASKS; i++) {
+        s->tasks[i] = (sched_task_t){ 0 };
+    }
+}
+
+/**
+ * @brief Register a task at a priority slot of the static pool
+ * @return 0 on success, -1 if the priority is out of range or already taken
+ */
+static inline int sched_create(scheduler_t *s, unsigned prio, sched_handler_t handler,
+                               void *arg, const char *name) {
+    if (prio >= SCHED_MAX_TASKS || handler == NULL || s->tasks[prio].handler != NULL) {
+        return -1;
+    }
+    sched_task_t *t = &s->tasks[prio];
+    t->handler = handler;
+    t->arg = arg;
+    t->name = name;
+    return 0;
+}
+
+/**
+ * @brief Post events to a task - callable from ISR context
+ * @return 0 on success, -1 if the priority is out of range
+ */
+static inline int sched_post(scheduler_t *s, unsigned prio, uint32_t events) {
+    if (prio >= SCHED_MAX_TASKS) {
+        return -1;
+    }
+    sched_task_t *t = &s->tasks[prio];
+#if SCHED_ACCOUNTING
+    // The first post stamps posted_at before the release that publishes its
+    // events, so the dispatcher's acquire can never pair them with an old stamp
+    uint32_t old = atomic_load_explicit(&t->events, memory_order_relaxed);
+    do {
+        if (old == 0) {
+            atomic_store_explicit(&t->posted_at, sched_ticks(), memory_order_relaxed);
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&t->events, &old, old | events,
+                                                    memory_order_release, memory_order_relaxed));
+#else
+    atomic_fetch_or_explicit(&t->events, events, memory_order_release);
+#endif
+    atomic_fetch_or_explicit(&s->ready, 1u << prio, memory_order_release);
+    return 0;
+}
+
+static inline bool sched_idle_check(scheduler_t *s) {
+    return atomic_load_explicit(&s->ready, memory_order_acquire) == 0;
+}
+
+/**
+ * @brief Run the highest-priority ready task to completion
+ * @return false if nothing was ready (caller may sleep until the next interrupt)
+ */
+static inline bool sched_dispatch(scheduler_t *s) {
+    uint32_t ready = atomic_load_explicit(&s->ready, memory_order_acquire);
+    if (ready == 0) {
+        return false;
+    }
+    unsigned prio = 31u - (unsigned)__builtin_clz(ready);
+    sched_task_t *t = &s->tasks[prio];
+
+    // Clear the ready bit before taking the events: a post that lands in
+    // between sets it again, so no event is ever stranded.
+    atomic_fetch_and_explicit(&s->ready, ~(1u << prio), memory_order_acq_rel);
+    uint32_t events = atomic_exchange_explicit(&t->events, 0, memory_order_acquire);
+    if (events == 0) {
+        return true;
+    }
+    // Read after the acquire, so it belongs to these events - unless a new
+    // first post has already restamped it, which the clamp below absorbs
+    uint32_t posted = atomic_load_explicit(&t->posted_at, memory_order_relaxed);
+
+#if SCHED_ACCOUNTING
+    uint64_t start = sched_now();
+    t->handler(t->arg, events);
+    uint64_t elapsed = sched_now() - start;
+
+    int32_t since_post = (int32_t)((uint32_t)start - posted);
+    uint64_t latency = since_post > 0 ? (uint64_t)since_post : 0;
+    t->runs++;
+    t->run_time_total += elapsed;
+    t->run_time_max = elapsed > t->run_time_max ? elapsed : t->run_time_max;
+    t->latency_total += latency;
+    t->latency_max = latency > t->latency_max ? latency : t->latency_max;
+#else
+    (void)posted;
+    t->handler(t->arg, events);
+    t->runs++;
+#endif
+    s->dispatches++;
+    return true;
+}
+
+static inline void sched_report(const scheduler_t *s) {
+    printf("%-4s %-14s %8s %12s %12s %12s %12s\n", "Prio", "Task", "Runs",
+           "Avg run ns", "Max run ns", "Avg lat ns", "Max lat ns");
+    for (int prio = SCHED_MAX_TASKS - 1; prio >= 0; prio--) {
+        const sched_task_t *t = &s->tasks[prio];
+        if (t->handler == NULL) {
+            continue;
+        }
+        uint32_t n = t->runs ? t->runs : 1;
+        printf("%-4d %-14s %8u %12llu %12llu %12llu %12llu\n", prio, t->name, t->runs,
+               (unsigned long long)(t->run_time_total / n), (unsigned long long)t->run_time_max,
+               (unsigned long long)(t->latency_total / n), (unsigned long long)t->latency_max);
+    }
+}
+
+#endif /* RTC_SCHEDULER_H */
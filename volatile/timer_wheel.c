@@ -0,0 +1,551 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* =============================================================================
+ * SECTION 1: Timer Object
+ * =============================================================================
+ * Timers are intrusive: the caller owns the storage (usually a field inside a
+ * protocol session), so starting a timer never allocates.
+ */
+
+typedef struct sw_timer sw_timer_t;
+typedef void (*sw_timer_cb_t)(sw_timer_t *t);
+
+struct sw_timer {
+    sw_timer_t *next;           // Wheel slot / sorted list links
+    sw_timer_t *prev;
+    uint32_t expires;           // Absolute tick
+    uint32_t heap_idx;          // Binary heap position (heap implementation only)
+    sw_timer_cb_t cb;
+    uint32_t id;
+};
+
+static inline bool sw_timer_pending(const sw_timer_t *t) {
+    return t->next != NULL;
+}
+
+// Doubly linked list with a sentinel head, shared by the wheel slots and the sorted list
+static inline void list_init(sw_timer_t *head) {
+    head->next = head->prev = head;
+}
+
+static inline bool list_empty(const sw_timer_t *head) {
+    return head->next == head;
+}
+
+static inline void list_insert_after(sw_timer_t *pos, sw_timer_t *t) {
+    t->prev = pos;
+    t->next = pos->next;
+    pos->next->prev = t;
+    pos->next = t;
+}
+
+static inline void list_unlink(sw_timer_t *t) {
+    t->prev->next = t->next;
+    t->next->prev = t->prev;
+    t->next = t->prev = NULL;
+}
+
+// Moves every element of `from` onto the empty list `to`
+static inline void list_splice(sw_timer_t *from, sw_timer_t *to) {
+    if (list_empty(from)) {
+        list_init(to);
+        return;
+    }
+    to->next = from->next;
+    to->prev = from->prev;
+    to->next->prev = to;
+    to->prev->next = to;
+    list_init(from);
+}
+
+/* =============================================================================
+ * SECTION 2: Hierarchical Timing Wheel
+ * =============================================================================
+ * Level 0 has one slot per tick for the next 256 ticks; each further level has
+ * 64 slots that are each 64x coarser. When level 0 wraps, the matching slot of
+ * level 1 is cascaded down (and level 2/3 when level 1 wraps). A timer is
+ * cascaded at most three times, so expiry is amortized O(1) per timer.
+ */
+
+#define TW_L0_BITS      8
+#define TW_LN_BITS      6
+#define TW_L0_SIZE      (1u << TW_L0_BITS)
+#define TW_LN_SIZE      (1u << TW_LN_BITS)
+#define TW_L0_MASK      (TW_L0_SIZE - 1)
+#define TW_LN_MASK      (TW_LN_SIZE - 1)
+#define TW_UPPER_LEVELS 3
+#define TW_MAX_DELTA    ((1u << (TW_L0_BITS + TW_UPPER_LEVELS * TW_LN_BITS)) - 1)
+
+typedef struct {
+    uint32_t next_tick;                             // Next tick to be processed
+    uint32_t pending;
+    sw_timer_t l0[TW_L0_SIZE];
+    sw_timer_t ln[TW_UPPER_LEVELS][TW_LN_SIZE];
+} timer_wheel_t;
+
+static void tw_init(timer_wheel_t *w, uint32_t now) {
+    w->next_tick = now + 1;
+    w->pending = 0;
+    for (unsigned i = 0; i < TW_L0_SIZE; i++) {
+        list_init(&w->l0[i]);
+    }
+    for (unsigned l = 0; l < TW_UPPER_LEVELS; l++) {
+        for (unsigned i = 0; i < TW_LN_SIZE; i++) {
+            list_init(&w->ln[l][i]);
+        }
+    }
+}
+
+static inline uint32_t tw_now(const timer_wheel_t *w) {
+    return w->next_tick - 1;
+}
+
+/**
+ * @brief Place a timer in the slot matching its distance from next_tick
+ */
+static void tw_enqueue(timer_wheel_t *w, sw_timer_t *t) {
+    uint32_t expires = t->expires;
+    uint32_t delta = expires - w->next_tick;
+    sw_timer_t *slot;
+
+    if ((int32_t)delta < 0) {
+        slot = &w->l0[w->next_tick & TW_L0_MASK];   // Already due: run on the next tick
+    } else if (delta < TW_L0_SIZE) {
+        slot = &w->l0[expires & TW_L0_MASK];
+    } else {
+        if (delta > TW_MAX_DELTA) {
+            expires = w->next_tick + TW_MAX_DELTA;  // Parked; re-slotted when cascaded
+            delta = TW_MAX_DELTA;
+        }
+        unsigned level = 0;
+        while (delta >= (1u << (TW_L0_BITS + (level + 1) * TW_LN_BITS))) {
+            level++;
+        }
+        slot = &w->ln[level][(expires >> (TW_L0_BITS + level * TW_LN_BITS)) & TW_LN_MASK];
+    }
+    list_insert_after(slot->prev, t);
+}
+
+/**
+ * @brief Start (or restart) a timer `delay` ticks from now - O(1)
+ */
+static void tw_start(timer_wheel_t *w, sw_timer_t *t, uint32_t delay) {
+    if (sw_timer_pending(t)) {
+        list_unlink(t);
+        w->pending--;
+    }
+    t->expires = tw_now(w) + (delay ? delay : 1);
+    tw_enqueue(w, t);
+    w->pending++;
+}
+
+/**
+ * @brief Cancel a pending timer - O(1)
+ * @return true if the timer was pending
+ */
+static bool tw_cancel(timer_wheel_t *w, sw_timer_t *t) {
+    if (!sw_timer_pending(t)) {
+        return false;
+    }
+    list_unlink(t);
+    w->pending--;
+    return true;
+}
+
+static unsigned tw_cascade(timer_wheel_t *w, unsigned level) {
+    unsigned index = (w->next_tick >> (TW_L0_BITS + level * TW_LN_BITS)) & TW_LN_MASK;
+    sw_timer_t work;
+
+    list_splice(&w->ln[level][index], &work);
+    while (!list_empty(&work)) {
+        sw_timer_t *t = work.next;
+        list_unlink(t);
+        tw_enqueue(w, t);
+    }
+    return index;
+}
+
+/**
+ * @brief Process every tick up to and including `now` and run expired callbacks
+ * Called from the main loop, never from the ISR.
+ * @return Number of callbacks run
+ */
+static uint32_t tw_run(timer_wheel_t *w, uint32_t now) {
+    uint32_t fired = 0;
+    sw_timer_t work;
+
+    while ((int32_t)(now - w->next_tick) >= 0) {
+        unsigned index = w->next_tick & TW_L0_MASK;
+
+        if (index == 0) {
+            for (unsigned l = 0; l < TW_UPPER_LEVELS && tw_cascade(w, l) == 0; l++) {
+            }
+        }
+        w->next_tick++;
+
+        list_splice(&w->l0[index], &work);
+        while (!list_empty(&work)) {
+            sw_timer_t *t = work.next;
+            list_unlink(t);
+            w->pending--;
+            fired++;
+            t->cb(t);       // May restart t or start other timers
+        }
+    }
+    return fired;
+}
+
+/* =============================================================================
+ * SECTION 3: Reference Implementations - Sorted List and Binary Heap
+ * ============================================================================= */
+
+typedef struct {
+    sw_timer_t head;
+    uint32_t now;
+} sorted_list_t;
+
+static void sl_init(sorted_list_t *s, uint32_t now) {
+    list_init(&s->head);
+    s->now = now;
+}
+
+// O(n): walks backwards from the tail, which is cheap only for FIFO-like deadlines
+static void sl_start(sorted_list_t *s, sw_timer_t *t, uint32_t delay) {
+    if (sw_timer_pending(t)) {
+        list_unlink(t);
+    }
+    t->expires = s->now + (delay ? delay : 1);
+    sw_timer_t *pos = s->head.prev;
+    while (pos != &s->head && (int32_t)(pos->expires - t->expires) > 0) {
+        pos = pos->prev;
+    }
+    list_insert_after(pos, t);
+}
+
+static bool sl_cancel(sorted_list_t *s, sw_timer_t *t) {
+    (void)s;
+    if (!sw_timer_pending(t)) {
+        return false;
+    }
+    list_unlink(t);
+    return true;
+}
+
+static uint32_t sl_run(sorted_list_t *s, uint32_t now) {
+    uint32_t fired = 0;
+    s->now = now;
+    while (!list_empty(&s->head) && (int32_t)(s->head.next->expires - now) <= 0) {
+        sw_timer_t *t = s->head.next;
+        list_unlink(t);
+        fired++;
+        t->cb(t);
+    }
+    return fired;
+}
+
+typedef struct {
+    sw_timer_t **a;
+    uint32_t size;
+    uint32_t capacity;
+    uint32_t now;
+} timer_heap_t;
+
+#define HEAP_NONE UINT32_MAX
+
+static bool heap_before(const sw_timer_t *x, const sw_timer_t *y) {
+    return (int32_t)(x->expires - y->expires) < 0;
+}
+
+static void heap_set(timer_heap_t *h, uint32_t i, sw_timer_t *t) {
+    h->a[i] = t;
+    t->heap_idx = i;
+}
+
+static void heap_sift_up(timer_heap_t *h, uint32_t i) {
+    sw_timer_t *t = h->a[i];
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (!heap_before(t, h->a[parent])) {
+            break;
+        }
+        heap_set(h, i, h->a[parent]);
+        i = parent;
+    }
+    heap_set(h, i, t);
+}
+
+static void heap_sift_down(timer_heap_t *h, uint32_t i) {
+    sw_timer_t *t = h->a[i];
+    for (;;) {
+        uint32_t child = 2 * i + 1;
+        if (child >= h->size) {
+            break;
+        }
+        if (child + 1 < h->size && heap_before(h->a[child + 1], h->a[child])) {
+            child++;
+        }
+        if (!heap_before(h->a[child], t)) {
+            break;
+        }
+        heap_set(h, i, h->a[child]);
+        i = child;
+    }
+    heap_set(h, i, t);
+}
+
+static bool heap_init(timer_heap_t *h, uint32_t capacity, uint32_t now) {
+    h->a = malloc((size_t)capacity * sizeof(*h->a));
+    h->size = 0;
+    h->capacity = capacity;
+    h->now = now;
+    return h->a != NULL;
+}
+
+// O(log n)
+static bool heap_cancel(timer_heap_t *h, sw_timer_t *t) {
+    uint32_t i = t->heap_idx;
+    if (i == HEAP_NONE) {
+        return false;
+    }
+    t->heap_idx = HEAP_NONE;
+    sw_timer_t *last = h->a[--h->size];
+    if (i < h->size) {
+        heap_set(h, i, last);
+        heap_sift_up(h, i);
+        heap_sift_down(h, last->heap_idx);
+    }
+    return true;
+}
+
+static void heap_start(timer_heap_t *h, sw_timer_t *t, uint32_t delay) {
+    heap_cancel(h, t);
+    t->expires = h->now + (delay ? delay : 1);
+    heap_set(h, h->size++, t);
+    heap_sift_up(h, h->size - 1);
+}
+
+static uint32_t heap_run(timer_heap_t *h, uint32_t now) {
+    uint32_t fired = 0;
+    h->now = now;
+    while (h->size > 0 && (int32_t)(h->a[0]->expires - now) <= 0) {
+        sw_timer_t *t = h->a[0];
+        heap_cancel(h, t);
+        fired++;
+        t->cb(t);
+    }
+    return fired;
+}
+
+/* =============================================================================
+ * SECTION 4: Tick Source - ISR Only Counts, Main Loop Expires
+ * ============================================================================= */
+
+typedef struct {
+    volatile uint32_t COUNTER;
+    volatile uint32_t RELOAD;
+    volatile uint32_t CONTROL;
+    volatile uint32_t STATUS;
+} TIMER_TypeDef;
+
+#define TIMER_OVERFLOW  (1 << 0)
+
+static TIMER_TypeDef sim_timer;
+#define TIMER   (&sim_timer)
+
+volatile uint32_t timer_overflow_count = 0;
+
+/**
+ * @brief Same ISR as volatile.c: O(1), no timer list is touched here
+ */
+void TIMER_IRQHandler(void) {
+    if (TIMER->STATUS & TIMER_OVERFLOW) {
+        timer_overflow_count++;
+        TIMER->STATUS &= ~TIMER_OVERFLOW;
+    }
+}
+
+static void sim_timer_overflow(void) {
+    TIMER->STATUS |= TIMER_OVERFLOW;
+    TIMER_IRQHandler();
+}
+
+static uint32_t demo_fired_at[3];
+
+static void demo_timeout(sw_timer_t *t) {
+    demo_fired_at[t->id] = timer_overflow_count;
+    printf("  timer %u expired at tick %u (due %u)\n", t->id, timer_overflow_count, t->expires);
+}
+
+static void demo_deferred_expiry(void) {
+    static timer_wheel_t wheel;
+    sw_timer_t t[3] = {{0}};
+
+    printf("\n=== Deferred Expiry Demo ===\n");
+    tw_init(&wheel, timer_overflow_count);
+    for (uint32_t i = 0; i < 3; i++) {
+        t[i].id = i;
+        t[i].cb = demo_timeout;
+    }
+    tw_start(&wheel, &t[0], 10);
+    tw_start(&wheel, &t[1], 300);       // Lives in level 1 until cascaded
+    tw_start(&wheel, &t[2], 20);
+    tw_cancel(&wheel, &t[2]);           // e.g. the ACK arrived in time
+
+    while (wheel.pending > 0) {
+        // Several overflows may land before the main loop gets around to it
+        for (int i = 0; i < 7; i++) {
+            sim_timer_overflow();
+        }
+        tw_run(&wheel, timer_overflow_count);
+    }
+    printf("  timer 2 was cancelled and never fired\n");
+}
+
+/* =============================================================================
+ * SECTION 5: Benchmark - 100k Concurrent Protocol Timeouts
+ * ============================================================================= */
+
+#define BENCH_TIMERS        100000u
+#define SORTED_LIST_TIMERS  10000u      // O(n) insert - kept small enough to finish
+#define MAX_DELAY           60000u      // e.g. 60 s at a 1 ms tick
+#define CHURN_PER_TIMER     4u          // Restarts per timer (ACK refreshes a timeout)
+#define CHURN_PER_TICK      64u
+
+static uint64_t fired_count;
+static uint64_t fired_sum;
+static uint64_t fired_late;
+static uint32_t bench_now;
+
+static void bench_cb(sw_timer_t *t) {
+    fired_count++;
+    fired_sum += (uint64_t)t->id * 2654435761u + t->expires;
+    fired_late += (t->expires != bench_now);
+}
+
+static uint32_t rng_state;
+
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static double seconds_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+typedef struct {
+    const char *name;
+    void *ctx;
+    void (*start)(void *ctx, sw_timer_t *t, uint32_t delay);
+    bool (*cancel)(void *ctx, sw_timer_t *t);
+    uint32_t (*run)(void *ctx, uint32_t now);
+} timer_ops_t;
+
+static void op_tw_start(void *c, sw_timer_t *t, uint32_t d) { tw_start(c, t, d); }
+static bool op_tw_cancel(void *c, sw_timer_t *t) { return tw_cancel(c, t); }
+static uint32_t op_tw_run(void *c, uint32_t now) { return tw_run(c, now); }
+static void op_sl_start(void *c, sw_timer_t *t, uint32_t d) { sl_start(c, t, d); }
+static bool op_sl_cancel(void *c, sw_timer_t *t) { return sl_cancel(c, t); }
+static uint32_t op_sl_run(void *c, uint32_t now) { return sl_run(c, now); }
+static void op_heap_start(void *c, sw_timer_t *t, uint32_t d) { heap_start(c, t, d); }
+static bool op_heap_cancel(void *c, sw_timer_t *t) { return heap_cancel(c, t); }
+static uint32_t op_heap_run(void *c, uint32_t now) { return heap_run(c, now); }
+
+/**
+ * @brief Start n timers, refresh them randomly while time advances, then drain
+ */
+static void bench_run(const timer_ops_t *ops, sw_timer_t *timers, uint32_t n, bool heap_index) {
+    fired_count = fired_sum = fired_late = 0;
+    bench_now = 0;
+    rng_state = 0x9E3779B9u;
+    for (uint32_t i = 0; i < n; i++) {
+        memset(&timers[i], 0, sizeof(timers[i]));
+        timers[i].id = i;
+        timers[i].cb = bench_cb;
+        timers[i].heap_idx = heap_index ? HEAP_NONE : 0;
+    }
+
+    double t0 = seconds_now();
+    for (uint32_t i = 0; i < n; i++) {
+        ops->start(ops->ctx, &timers[i], 1 + rng_next() % MAX_DELAY);
+    }
+    double t1 = seconds_now();
+
+    uint32_t churn = n * CHURN_PER_TIMER;
+    for (uint32_t i = 0; i < churn; i++) {
+        sw_timer_t *t = &timers[rng_next() % n];
+        ops->cancel(ops->ctx, t);
+        ops->start(ops->ctx, t, 1 + rng_next() % MAX_DELAY);
+        if (i % CHURN_PER_TICK == 0) {
+            ops->run(ops->ctx, ++bench_now);
+        }
+    }
+    double t2 = seconds_now();
+
+    uint32_t ticks_before_drain = bench_now;
+    while (bench_now < ticks_before_drain + 2 * MAX_DELAY) {
+        ops->run(ops->ctx, ++bench_now);
+    }
+    double t3 = seconds_now();
+
+    printf("%-12s %7u timers | start %7.1f ns | cancel+restart %7.1f ns | drain %6.1f ns/tick"
+           " | fired %llu, late %llu, sum %016llx\n",
+           ops->name, n,
+           (t1 - t0) * 1e9 / n,
+           (t2 - t1) * 1e9 / churn,
+           (t3 - t2) * 1e9 / (bench_now - ticks_before_drain),
+           (unsigned long long)fired_count, (unsigned long long)fired_late,
+           (unsigned long long)fired_sum);
+}
+
+int main(void) {
+    printf("=======================================================\n");
+    printf("     HIERARCHICAL TIMING WHEEL vs LIST vs HEAP\n");
+    printf("=======================================================\n");
+
+    demo_deferred_expiry();
+
+    static timer_wheel_t wheel;
+    static sorted_list_t list;
+    static timer_heap_t heap;
+    sw_timer_t *timers = calloc(BENCH_TIMERS, sizeof(*timers));
+    if (timers == NULL || !heap_init(&heap, BENCH_TIMERS, 0)) {
+        printf("Allocation failed\n");
+        return 1;
+    }
+
+    timer_ops_t ops[3] = {
+        { "wheel",       &wheel, op_tw_start,   op_tw_cancel,   op_tw_run },
+        { "binary heap", &heap,  op_heap_start, op_heap_cancel, op_heap_run },
+        { "sorted list", &list,  op_sl_start,   op_sl_cancel,   op_sl_run },
+    };
+
+    printf("\n=== Benchmark: delays 1..%u ticks, %u restarts per timer ===\n",
+           MAX_DELAY, CHURN_PER_TIMER);
+    tw_init(&wheel, 0);
+    bench_run(&ops[0], timers, BENCH_TIMERS, false);
+    heap.now = 0;
+    bench_run(&ops[1], timers, BENCH_TIMERS, true);
+
+    printf("Same workload at %u timers (sorted list is O(n) per insert):\n", SORTED_LIST_TIMERS);
+    tw_init(&wheel, 0);
+    bench_run(&ops[0], timers, SORTED_LIST_TIMERS, false);
+    heap.now = 0;
+    bench_run(&ops[1], timers, SORTED_LIST_TIMERS, true);
+    sl_init(&list, 0);
+    bench_run(&ops[2], timers, SORTED_LIST_TIMERS, false);
+
+    free(heap.a);
+    free(timers);
+    return 0;
+}
@@ -5,6 +5,9 @@
 #include <signal.h>
 #include <time.h>
 
+#include "reg_trace.h"
+#include "rtc_scheduler.h"
+
 /* =============================================================================
  * SECTION 1: Memory-Mapped I/O Register Definitions
  * ============================================================================= */
@@ -22,7 +25,9 @@ typedef struct {
     volatile uint32_t DIRECTION;    // 0x08: Pin direction (0=input, 1=output)
     volatile uint32_t PULLUP;       // 0x0C: Pull-up enable
     volatile uint32_t INTERRUPT;    // 0x10: Interrupt status/clear
-    volatile uint32_t RESERVED[3];  // 0x14-0x1C: Reserved
+    volatile uint32_t SET;          // 0x14: Write-only, 1 = drive pin high
+    volatile uint32_t CLEAR;        // 0x18: Write-only, 1 = drive pin low
+    volatile uint32_t BSRR;         // 0x1C: Write-only, bits 0-15 set / 16-31 reset pins 0-15
 } GPIO_TypeDef;
 
 // UART Register Structure
@@ -42,9 +47,34 @@ typedef struct {
 } TIMER_TypeDef;
 
 // Hardware register mapping (in real embedded system)
+// Build with -DSIMULATED_HW to run on a host: the register blocks then live in RAM
+#ifdef SIMULATED_HW
+static GPIO_TypeDef  simulated_gpio;
+static UART_TypeDef  simulated_uart = { .STATUS = (1 << 1), .BAUDRATE = 9600 };
+static TIMER_TypeDef simulated_timer = { .RELOAD = 1000, .CONTROL = (1 << 0) };
+#define GPIO    (&simulated_gpio)
+#define UART    (&simulated_uart)
+#define TIMER   (&simulated_timer)
+
+// SET/CLEAR/BSRR are write-only: the port applies them to OUTPUT and they
+// read back as zero. RAM does neither, so each write to one is followed by
+// gpio_sim_apply() (the same model as gpio_sim_bus() in gpio_bitbang.c).
+static void gpio_sim_apply(GPIO_TypeDef *port) {
+    uint32_t out = port->OUTPUT;
+    uint32_t bsrr = port->BSRR;
+    out &= ~port->CLEAR;
+    out |= port->SET;
+    out &= ~(bsrr >> 16);
+    out |= bsrr & 0xFFFF;               // Set wins over reset
+    port->SET = port->CLEAR = port->BSRR = 0;
+    port->OUTPUT = out;
+}
+#else
+#define gpio_sim_apply(port)    ((void)(port))
 #define GPIO    ((GPIO_TypeDef*)GPIO_BASE_ADDR)
 #define UART    ((UART_TypeDef*)UART_BASE_ADDR)
 #define TIMER   ((TIMER_TypeDef*)TIMER_BASE_ADDR)
+#endif
 
 // Status register bit definitions
 #define UART_RX_READY   (1 << 0)
@@ -68,8 +98,17 @@ volatile bool system_shutdown = false;
 static uint32_t *non_volatile_register = (uint32_t*)0x40020000;
 static volatile uint32_t *volatile_register = (volatile uint32_t*)0x40020000;
 
-// Shared flag between threads/interrupts
-volatile bool processing_complete = false;
+// Run-to-completion scheduler (rtc_scheduler.h): ISRs post events, main dispatches
+// Higher number = higher priority
+static scheduler_t scheduler;
+
+#define TASK_HOUSEKEEPING   1
+#define TASK_PROCESSING     2
+#define TASK_UART_RX        3
+
+#define EV_UART_RX      (1u << 0)
+#define EV_TIMER_TICK   (1u << 0)
+#define EV_PROCESS      (1u << 0)
 
 /* =============================================================================
  * SECTION 3: Compiler Optimization Demonstration Functions
@@ -162,6 +201,31 @@ void demonstrate_assembly_differences(void) {
  * SECTION 4: Memory-Mapped I/O Examples
  * ============================================================================= */
 
+/**
+ * @brief Change several pins of a port in one bus write
+ * SET/CLEAR/BSRR are write-only, so no volatile read is needed and an ISR
+ * touching other pins of the same port cannot be overwritten.
+ * If a pin is in both masks, set wins (same rule as BSRR hardware).
+ */
+static inline void gpio_port_update(GPIO_TypeDef *port, uint32_t set_mask, uint32_t clear_mask) {
+    if (((set_mask | clear_mask) >> 16) == 0) {
+        REG_WR(port->BSRR, set_mask | (clear_mask << 16));  // Pins 0-15: one write
+        gpio_sim_apply(port);
+    } else {
+        REG_WR(port->CLEAR, clear_mask & ~set_mask);
+        gpio_sim_apply(port);
+        REG_WR(port->SET, set_mask);
+        gpio_sim_apply(port);
+    }
+}
+
+/**
+ * @brief Drive the pins in `mask` to the matching bits of `value`
+ */
+static inline void gpio_port_write(GPIO_TypeDef *port, uint32_t mask, uint32_t value) {
+    gpio_port_update(port, value & mask, ~value & mask);
+}
+
 /**
  * @brief GPIO manipulation using memory-mapped registers
  */
@@ -169,27 +233,41 @@ void gpio_operations_example(void) {
     printf("\n=== GPIO Memory-Mapped I/O Example ===\n");
     
     // Configure pin 5 as output
-    GPIO->DIRECTION |= (1 << 5);
+    REG_WR(GPIO->DIRECTION, REG_RD(GPIO->DIRECTION) | (1 << 5));
     printf("Configured GPIO pin 5 as output\n");
     
     // Set pin 5 high
-    GPIO->OUTPUT |= (1 << 5);
-    printf("Set GPIO pin 5 HIGH\n");
+    // OUTPUT |= costs a volatile read plus a write, and an ISR that changes
+    // another pin between the two accesses gets its update overwritten.
+    // The write-only SET register does the same in one access, atomically.
+    REG_WR(GPIO->SET, 1 << 5);
+    gpio_sim_apply(GPIO);
+    printf("Set GPIO pin 5 HIGH (OUTPUT = 0x%08X)\n", REG_RD(GPIO->OUTPUT));
     
     // Read input pin 3
-    if (GPIO->INPUT & (1 << 3)) {
+    if (REG_RD(GPIO->INPUT) & (1 << 3)) {
         printf("GPIO pin 3 is HIGH\n");
     } else {
         printf("GPIO pin 3 is LOW\n");
     }
     
     // Toggle pin 5
-    GPIO->OUTPUT ^= (1 << 5);
-    printf("Toggled GPIO pin 5\n");
-    
-    // Clear pin 5
-    GPIO->OUTPUT &= ~(1 << 5);
-    printf("Set GPIO pin 5 LOW\n");
+    // Toggle still needs to know the current level, so it stays read-modify-write
+    REG_WR(GPIO->OUTPUT, REG_RD(GPIO->OUTPUT) ^ (1 << 5));
+    printf("Toggled GPIO pin 5 (OUTPUT = 0x%08X)\n", REG_RD(GPIO->OUTPUT));
+    
+    // Set pin 5 again, then clear it
+    REG_WR(GPIO->SET, 1 << 5);
+    gpio_sim_apply(GPIO);
+    REG_WR(GPIO->CLEAR, 1 << 5);
+    gpio_sim_apply(GPIO);
+    printf("Set GPIO pin 5 LOW (OUTPUT = 0x%08X)\n", REG_RD(GPIO->OUTPUT));
+    
+    // Batched update: pins 0-3 become 0b1010 in a single BSRR write
+    REG_WR(GPIO->SET, 0x05);            // Start from 0b0101 so every pin changes
+    gpio_sim_apply(GPIO);
+    gpio_port_write(GPIO, 0x0F, 0x0A);
+    printf("Wrote pins 0-3 = 0xA in one bus write (OUTPUT = 0x%08X)\n", REG_RD(GPIO->OUTPUT));
 }
 
 /**
@@ -199,24 +277,24 @@ void uart_communication_example(void) {
     printf("\n=== UART Communication Example ===\n");
     
     // Wait for transmit buffer to be empty
-    while (!(UART->STATUS & UART_TX_EMPTY)) {
+    while (!(REG_RD(UART->STATUS) & UART_TX_EMPTY)) {
         // volatile ensures we read status register each time
         // Hardware updates this bit when buffer becomes empty
     }
     
     // Send a byte
-    UART->DATA = 'A';
+    REG_WR(UART->DATA, 'A');
     printf("Sent byte 'A' via UART\n");
     
     // Wait for receive data
     uint32_t timeout = 100000;
-    while (!(UART->STATUS & UART_RX_READY) && timeout > 0) {
+    while (!(REG_RD(UART->STATUS) & UART_RX_READY) && timeout > 0) {
         timeout--;
         // Without volatile, this might become infinite loop
     }
     
-    if (UART->STATUS & UART_RX_READY) {
-        uint8_t received = UART->DATA & 0xFF;
+    if (REG_RD(UART->STATUS) & UART_RX_READY) {
+        uint8_t received = REG_RD(UART->DATA) & 0xFF;
         printf("Received byte: 0x%02X ('%c')\n", received, 
                (received >= 32 && received <= 126) ? received : '?');
     } else {
@@ -231,8 +309,8 @@ void timer_operations_example(void) {
     printf("\n=== Timer Operations Example ===\n");
     
     // Configure timer
-    TIMER->RELOAD = 1000;           // Set reload value
-    TIMER->CONTROL |= TIMER_ENABLE; // Enable timer
+    REG_WR(TIMER->RELOAD, 1000);    // Set reload value
+    REG_WR(TIMER->CONTROL, REG_RD(TIMER->CONTROL) | TIMER_ENABLE); // Enable timer
     printf("Timer configured and started\n");
     
     // Wait for timer overflow
@@ -244,9 +322,9 @@ void timer_operations_example(void) {
         // which is modified by interrupt service routine
         
         // Check timer status register
-        if (TIMER->STATUS & TIMER_OVERFLOW) {
+        if (REG_RD(TIMER->STATUS) & TIMER_OVERFLOW) {
             printf("Timer overflow detected in status register\n");
-            TIMER->STATUS |= TIMER_OVERFLOW; // Clear flag
+            REG_WR(TIMER->STATUS, REG_RD(TIMER->STATUS) | TIMER_OVERFLOW); // Clear flag
             break;
         }
     }
@@ -264,23 +342,26 @@ void timer_operations_example(void) {
  */
 void UART_IRQHandler(void) {
     // Check if receive interrupt
-    if (UART->STATUS & UART_RX_READY) {
+    if (REG_RD(UART->STATUS) & UART_RX_READY) {
         // Read data from hardware register
-        uart_received_data = UART->DATA & 0xFF;
+        uart_received_data = REG_RD(UART->DATA) & 0xFF;
         
         // Set flag for main program
         uart_data_ready = true;  // MUST be volatile!
         
+        // Make the receive task ready; it runs once this ISR returns
+        sched_post(&scheduler, TASK_UART_RX, EV_UART_RX);
+        
         // Clear interrupt flag
-        UART->STATUS |= UART_RX_READY;
+        REG_WR(UART->STATUS, REG_RD(UART->STATUS) | UART_RX_READY);
         
         printf("[ISR] UART data received: 0x%02X\n", uart_received_data);
     }
     
     // Check for errors
-    if (UART->STATUS & UART_ERROR) {
+    if (REG_RD(UART->STATUS) & UART_ERROR) {
         printf("[ISR] UART error detected!\n");
-        UART->STATUS |= UART_ERROR; // Clear error flag
+        REG_WR(UART->STATUS, REG_RD(UART->STATUS) | UART_ERROR); // Clear error flag
     }
 }
 
@@ -288,12 +369,13 @@ void UART_IRQHandler(void) {
  * @brief Simulated Timer interrupt service routine
  */
 void TIMER_IRQHandler(void) {
-    if (TIMER->STATUS & TIMER_OVERFLOW) {
+    if (REG_RD(TIMER->STATUS) & TIMER_OVERFLOW) {
         // Increment overflow counter
         timer_overflow_count++;  // MUST be volatile!
+        sched_post(&scheduler, TASK_HOUSEKEEPING, EV_TIMER_TICK);
         
         // Clear interrupt flag
-        TIMER->STATUS |= TIMER_OVERFLOW;
+        REG_WR(TIMER->STATUS, REG_RD(TIMER->STATUS) | TIMER_OVERFLOW);
         
         printf("[ISR] Timer overflow #%u\n", timer_overflow_count);
         
@@ -317,10 +399,23 @@ void signal_handler(int sig) {
     
     if (sig == SIGALRM) {
         if (call_count % 2 == 0) {
+#ifdef SIMULATED_HW
+            // Simulated hardware: a byte arrives and raises RX_READY
+            UART->DATA = 0x40 + (uint32_t)call_count;
+            UART->STATUS |= UART_RX_READY;
+#endif
             UART_IRQHandler();
         } else {
+#ifdef SIMULATED_HW
+            TIMER->STATUS |= TIMER_OVERFLOW;
+#endif
             TIMER_IRQHandler();
         }
+#ifdef SIMULATED_HW
+        // Flags are write-1-to-clear in hardware; RAM cannot model that
+        UART->STATUS &= ~UART_RX_READY;
+        TIMER->STATUS &= ~TIMER_OVERFLOW;
+#endif
     }
 }
 
@@ -401,10 +496,10 @@ void volatile_best_practices(void) {
     printf("\n=== Volatile Best Practices ===\n");
     
     // 1. Always use volatile for memory-mapped registers
-    volatile uint32_t *correct_reg = (volatile uint32_t*)0x40020000;
+    volatile uint32_t *correct_reg = &GPIO->INPUT;                  // 0x40020000
     
     // 2. Use const volatile for read-only hardware registers
-    const volatile uint32_t *readonly_reg = (const volatile uint32_t*)0x40020004;
+    const volatile uint32_t *readonly_reg = &GPIO->OUTPUT;          // 0x40020004
     
     // 3. Volatile pointers vs pointer to volatile
     volatile uint32_t *ptr_to_volatile;     // Pointer to volatile data
@@ -448,7 +543,55 @@ void common_volatile_mistakes(void) {
 }
 
 /* =============================================================================
- * SECTION 9: Main Demonstration Function
+ * SECTION 9: Run-to-Completion Tasks
+ * =============================================================================
+ * Replaces the fixed super loop that polled uart_data_ready and
+ * processing_complete once per second: each ISR posts an event, and the
+ * highest-priority ready task runs as soon as the ISR returns.
+ */
+
+static void uart_rx_task(void *arg, uint32_t events) {
+    (void)arg;
+    (void)events;
+    printf("Task: Processing UART data: 0x%02X\n", uart_received_data);
+    uart_data_ready = false;  // Clear flag
+    
+    // Hand off the slower part of the work at lower priority
+    sched_post(&scheduler, TASK_PROCESSING, EV_PROCESS);
+    alarm(1);  // Trigger next interrupt
+}
+
+static void processing_task(void *arg, uint32_t events) {
+    (void)arg;
+    (void)events;
+    printf("Task: Processing completed\n");
+}
+
+static void housekeeping_task(void *arg, uint32_t events) {
+    (void)arg;
+    (void)events;
+    printf("Task: Timer tick (timer overflows: %u)\n", timer_overflow_count);
+    alarm(1);  // Trigger next interrupt
+}
+
+/**
+ * @brief Sleep until the next interrupt when no task is ready
+ * SIGALRM is blocked while checking so a post cannot slip in between the
+ * check and the sleep. On target this is the __WFI() instruction.
+ */
+static void idle_wait_for_interrupt(void) {
+    sigset_t block, old;
+    sigemptyset(&block);
+    sigaddset(&block, SIGALRM);
+    sigprocmask(SIG_BLOCK, &block, &old);
+    if (sched_idle_check(&scheduler) && !system_shutdown) {
+        sigsuspend(&old);
+    }
+    sigprocmask(SIG_SETMASK, &old, NULL);
+}
+
+/* =============================================================================
+ * SECTION 10: Main Demonstration Function
  * ============================================================================= */
 
 int main(void) {
@@ -456,18 +599,31 @@ int main(void) {
     printf("     VOLATILE KEYWORD COMPREHENSIVE DEMONSTRATION\n");
     printf("=======================================================\n");
     
+    // Tasks must exist before the first interrupt can post to them
+    sched_init(&scheduler);
+    sched_create(&scheduler, TASK_UART_RX, uart_rx_task, NULL, "uart_rx");
+    sched_create(&scheduler, TASK_PROCESSING, processing_task, NULL, "processing");
+    sched_create(&scheduler, TASK_HOUSEKEEPING, housekeeping_task, NULL, "housekeeping");
+    
     // Set up signal handler to simulate interrupts
     signal(SIGALRM, signal_handler);
     alarm(1);  // Trigger signal in 1 second
     
-    // Initialize simulated hardware registers with dummy values
+    // Simulated hardware registers (-DSIMULATED_HW) are set up in SECTION 1
     // In real system, these would be actual hardware addresses
-    static uint32_t simulated_gpio[8] = {0};
-    static uint32_t simulated_uart[4] = {UART_TX_EMPTY, 0, 0, 9600};
-    static uint32_t simulated_timer[4] = {0, 1000, TIMER_ENABLE, 0};
     
-    // Point our register pointers to simulated memory
-    // (In real embedded system, these would be actual hardware addresses)
+    // Names for the register access report (no-op unless built with -DREG_TRACE)
+    REG_TRACE_NAME(GPIO->INPUT);
+    REG_TRACE_NAME(GPIO->OUTPUT);
+    REG_TRACE_NAME(GPIO->DIRECTION);
+    REG_TRACE_NAME(GPIO->SET);
+    REG_TRACE_NAME(GPIO->CLEAR);
+    REG_TRACE_NAME(GPIO->BSRR);
+    REG_TRACE_NAME(UART->DATA);
+    REG_TRACE_NAME(UART->STATUS);
+    REG_TRACE_NAME(TIMER->RELOAD);
+    REG_TRACE_NAME(TIMER->CONTROL);
+    REG_TRACE_NAME(TIMER->STATUS);
     
     printf("Compiler: %s\n", __VERSION__);
     printf("Compilation date: %s %s\n", __DATE__, __TIME__);
@@ -486,26 +642,15 @@ int main(void) {
     printf("\n=== Interrupt Handling Demonstration ===\n");
     printf("Waiting for interrupts (simulated via signals)...\n");
     
-    int wait_count = 0;
-    while (!system_shutdown && wait_count < 10) {
-        if (uart_data_ready) {
-            printf("Main: Processing UART data: 0x%02X\n", uart_received_data);
-            uart_data_ready = false;  // Clear flag
+    while (!system_shutdown) {
+        if (!sched_dispatch(&scheduler)) {
+            idle_wait_for_interrupt();
         }
-        
-        if (processing_complete) {
-            printf("Main: Processing completed\n");
-            processing_complete = false;
-        }
-        
-        printf("Main loop iteration %d (timer overflows: %u)\n", 
-               wait_count, timer_overflow_count);
-        
-        sleep(1);  // Simulate work
-        wait_count++;
-        alarm(1);  // Trigger next interrupt
     }
     
+    printf("\n=== Task Accounting ===\n");
+    sched_report(&scheduler);
+    
     printf("\n=== Demonstration Complete ===\n");
     printf("Key Takeaways:\n");
     printf("1. Use volatile for hardware registers\n");